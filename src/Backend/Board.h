@@ -10,10 +10,13 @@
 #include <cassert>
 #include <iostream>
 #include <string>
+#include <string_view>
 
+#include "Type/AttackRecord.h"
 #include "Type/BitBoard.h"
 #include "Type/CheckBitBoard.h"
 #include "Type/Color.h"
+#include "Type/InternalMove.h"
 #include "Type/Piece.h"
 #include "Type/PieceColor.h"
 #include "Type/PinBitBoard.h"
@@ -33,7 +36,10 @@
 namespace StockDory
 {
 
-    class Board
+    // The board is laid out densely so that it spans three cache lines (being copied into every search thread, and
+    // on every move when searching with copy-make): the bitboards move generation reads share the first, the mailbox
+    // takes the second, and the state that changes from move to move takes the third
+    class alignas(64) Board
     {
 
         constexpr static uint8_t CastlingMask     = 0xF;
@@ -50,122 +56,173 @@ namespace StockDory
             0
         };
 
-        std::array<std::array<BitBoard, 7>, 3> BB {};
+        // Conventional material value of each piece in pawns (the king doesn't count towards material)
+        constexpr static std::array<uint8_t, 6> MaterialValue { 1, 3, 3, 5, 9, 0 };
+
+        // Weight of each piece in the material the search scales the evaluation by (pawns and the king don't count)
+        constexpr static std::array<uint16_t, 6> MaterialScalingWeight { 0, 308, 346, 521, 994, 0 };
+
+        // One bitboard per piece type (both colors) and one per color, a piece of a color being the intersection of
+        // the two. The empty squares are the complement of both colors
+        std::array<BitBoard, 6> PieceBB {};
+        std::array<BitBoard, 2> ColorBB {};
 
         std::array<PieceColor, 64> PieceAndColor {};
 
-        std::array<BitBoard, 3> ColorBB {};
+        BitBoard EnPassantTarget = BBDefault;
+
+        ZobristHash Hash = 0;
+
+        // Hash of the pawns alone, kept up to date alongside the full hash
+        ZobristHash PawnHash = 0;
+
+        // Piece counts (both colors together) and the total material, kept up to date alongside the bitboards so that
+        // material queries don't have to count bits
+        std::array<uint8_t, 6> PieceCounts {};
+
+        uint8_t  TotalPieceCount       = 0;
+        uint16_t TotalMaterial         = 0;
+        uint16_t TotalWeightedMaterial = 0;
 
         // [COLOR TO MOVE] [WHITE KING CASTLE] [WHITE QUEEN CASTLE] [BLACK KING CASTLE] [BLACK QUEEN CASTLE]
         // [    4 BITS   ] [      1 BIT      ] [       1 BIT      ] [      1 BIT      ] [       1 BIT      ]
         uint8_t CastlingRightAndColorToMove = 0;
 
-        BitBoard EnPassantTarget = BBDefault;
+        public:
+        // The longest FEN possible: 64 pieces and 7 separators in the position, the color to move, all four castling
+        // rights, an en passant square, and both move clocks at their limit, with the fields space-separated
+        constexpr static size_t MaxFenLength = 71 + 1 + 1 + 1 + 4 + 1 + 2 + 1 + 3 + 1 + 5;
 
-        ZobristHash Hash = 0;
+        using FenBuffer = std::array<char, MaxFenLength>;
 
-        public:
         Board() : Board("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") {}
 
-        Board(const std::string& fen)
+        // Parses the FEN in a single pass over the view, without splitting it into strings. The move clocks aren't
+        // part of the board and are left to the caller
+        Board(const std::string_view fen)
         {
             constexpr auto none = PieceColor(NAP, NAC);
             std::ranges::fill(PieceAndColor, none);
 
-            for (uint8_t i = 0; i < 3; i++)
-                std::ranges::fill(BB[i], BBDefault);
+            size_t i = 0;
 
-            const std::vector<std::string> splitFen = strutil::split(fen, " ");
-
-            assert(splitFen.size() == 6);
+            const auto field = [&fen, &i] -> std::string_view
+            {
+                while (i < fen.size() && fen[i] == ' ') i++;
+
+                const size_t start = i;
+                while (i < fen.size() && fen[i] != ' ') i++;
+
+                return fen.substr(start, i - start);
+            };
+
+            const std::string_view position  = field();
+            const std::string_view side      = field();
+            const std::string_view castling  = field();
+            const std::string_view enPassant = field();
+
+            // The position is given from the eighth rank down, and from the A-file to the H-file within a rank
+            uint8_t v = 7;
+            uint8_t h = 0;
+            for (const char p: position) {
+                if (p == '/') {
+                    v--;
+                    h = 0;
+                    continue;
+                }
 
-            std::vector<std::string> splitPosition = strutil::split(splitFen[0], "/");
-            std::ranges::reverse(splitPosition);
+                if (isdigit(p)) {
+                    h += static_cast<uint8_t>(p - 48);
+                    continue;
+                }
 
-            assert(splitPosition.size() == 8);
+                Color color = Black;
+
+                if (isupper(p)) color = White;
+
+                Piece piece = NAP;
+                switch (tolower(p)) {
+                    case 'p':
+                        piece = Pawn;
+                        break;
+                    case 'n':
+                        piece = Knight;
+                        break;
+                    case 'b':
+                        piece = Bishop;
+                        break;
+                    case 'r':
+                        piece = Rook;
+                        break;
+                    case 'q':
+                        piece = Queen;
+                        break;
+                    case 'k':
+                        piece = King;
+                        break;
+                    default:;
+                }
 
-            for (uint8_t v = 0; v < 8; v++) {
-                std::string& rankStr = splitPosition[v];
-                uint8_t      h       = 0;
-                for (const char p: rankStr) {
-                    if (isdigit(p)) {
-                        h += static_cast<uint8_t>(p - 48);
-                        continue;
-                    }
+                if (piece == NAP || v > 7 || h > 7) {
+                    std::cout << "ERROR" << std::endl;
 
-                    Color color = Black;
-
-                    if (isupper(p)) color = White;
-
-                    Piece piece = NAP;
-                    switch (tolower(p)) {
-                        case 'p':
-                            piece = Pawn;
-                            break;
-                        case 'n':
-                            piece = Knight;
-                            break;
-                        case 'b':
-                            piece = Bishop;
-                            break;
-                        case 'r':
-                            piece = Rook;
-                            break;
-                        case 'q':
-                            piece = Queen;
-                            break;
-                        case 'k':
-                            piece = King;
-                            break;
-                        default:;
-                    }
+                    h++;
+                    continue;
+                }
 
-                    uint8_t    idx = v * 8 + h;
-                    const auto sq  = static_cast<Square>(idx);
+                const auto sq = static_cast<Square>(v * 8 + h);
 
-                    Set<true>(BB[color][piece], sq);
+                Set<true>(PieceBB[piece], sq);
+                Set<true>(ColorBB[color], sq);
 
-                    PieceAndColor[idx] = PieceColor(piece, color);
+                PieceAndColor[sq] = PieceColor(piece, color);
 
-                    if (piece == NAP) std::cout << "ERROR" << std::endl;
+                PieceCounts[piece]++;
+                TotalPieceCount++;
+                TotalMaterial         += MaterialValue        [piece];
+                TotalWeightedMaterial += MaterialScalingWeight[piece];
 
-                    Hash = Zobrist::HashPiece<ZOBRIST>(Hash, piece, color, sq);
+                Hash     = Zobrist::HashPiece<ZOBRIST>(    Hash, piece, color, sq);
+                PawnHash = Zobrist::HashPawn <ZOBRIST>(PawnHash, piece, color, sq);
 
-                    h++;
-                }
+                h++;
             }
 
-            if (splitFen[1][0] == 'w') {
+            if (!side.empty() && side[0] == 'w') {
                 CastlingRightAndColorToMove = White << 4;
                 Hash                        = Zobrist::HashColorFlip<ZOBRIST>(Hash);
             } else {
                 CastlingRightAndColorToMove = Black << 4;
             }
 
-            const std::string& castlingData = splitFen[2];
-            CastlingRightAndColorToMove |= castlingData.find('K') != std::string::npos ? WhiteKCastleMask : 0x0;
-            CastlingRightAndColorToMove |= castlingData.find('Q') != std::string::npos ? WhiteQCastleMask : 0x0;
-            CastlingRightAndColorToMove |= castlingData.find('k') != std::string::npos ? BlackKCastleMask : 0x0;
-            CastlingRightAndColorToMove |= castlingData.find('q') != std::string::npos ? BlackQCastleMask : 0x0;
+            for (const char c: castling) {
+                switch (c) {
+                    case 'K':
+                        CastlingRightAndColorToMove |= WhiteKCastleMask;
+                        break;
+                    case 'Q':
+                        CastlingRightAndColorToMove |= WhiteQCastleMask;
+                        break;
+                    case 'k':
+                        CastlingRightAndColorToMove |= BlackKCastleMask;
+                        break;
+                    case 'q':
+                        CastlingRightAndColorToMove |= BlackQCastleMask;
+                        break;
+                    default:;
+                }
+            }
 
             Hash = Zobrist::HashCastling<ZOBRIST>(Hash, CastlingRightAndColorToMove & CastlingMask);
 
-            EnPassantTarget     = BBDefault;
-            if (const std::string& epData = splitFen[3]; epData.length() == 2) {
-                if (const Square epSq = FromString(epData);
-                    AttackTable::Pawn[Opposite(ColorToMove())][epSq] & BB[ColorToMove()][Pawn]) {
+            EnPassantTarget = BBDefault;
+            if (enPassant.length() == 2) {
+                if (const Square epSq = FromString(enPassant);
+                    AttackTable::Pawn[Opposite(ColorToMove())][epSq] & PieceBoard(Pawn, ColorToMove())) {
                     EnPassantTarget = FromSquare(epSq);
                     Hash            = Zobrist::HashEnPassant<ZOBRIST>(Hash, epSq);
                 }
             }
-
-            ColorBB[White] = BBDefault;
-            ColorBB[Black] = BBDefault;
-            for (Piece p = Pawn; p != NAP; p = Next(p)) {
-                ColorBB[White] |= BB[White][p];
-                ColorBB[Black] |= BB[Black][p];
-            }
-            ColorBB[NAC] = ~(ColorBB[White] | ColorBB[Black]);
         }
 
         void LoadForEvaluation(const size_t threadId = 0) const
@@ -180,92 +237,66 @@ namespace StockDory
             }
         }
 
-        std::string Fen() const
+        // Writes the FEN into the buffer and returns its length, so that it can be produced without allocating
+        size_t Fen(FenBuffer& buffer) const
         {
-            std::array<std::string, 8> fenRank;
+            size_t n = 0;
 
-            for (uint8_t v = 0; v < 8; v++) {
-                std::stringstream rankStr;
-                uint8_t           e = 0;
+            for (uint8_t v = 8; v-- > 0;) {
+                uint8_t e = 0;
                 for (uint8_t h = 0; h < 8; h++) {
                     const PieceColor pc = PieceAndColor[v * 8 + h];
 
                     if (pc.Piece() == NAP) {
                         e++;
-
-                        if (h == 7) {
-                            rankStr << static_cast<uint16_t>(e);
-                            e = 0;
-                        }
                         continue;
                     }
 
                     if (e != 0) {
-                        rankStr << static_cast<uint16_t>(e);
+                        buffer[n++] = static_cast<char>('0' + e);
                         e = 0;
                     }
 
-                    char p = ' ';
-
-                    switch (pc.Piece()) {
-                        case Pawn:
-                            p = 'p';
-                            break;
-                        case Knight:
-                            p = 'n';
-                            break;
-                        case Bishop:
-                            p = 'b';
-                            break;
-                        case Rook:
-                            p = 'r';
-                            break;
-                        case Queen:
-                            p = 'q';
-                            break;
-                        case King:
-                            p = 'k';
-                            break;
-                        case NAP:
-                            break;
-                    }
+                    const char p = FirstLetter(pc.Piece());
 
-                    if (pc.Color() == White) p = static_cast<char>(toupper(p));
-
-                    rankStr << p;
+                    buffer[n++] = pc.Color() == White ? p : static_cast<char>(tolower(p));
                 }
 
-                fenRank[v] = rankStr.str();
-            }
-
-            std::stringstream fen;
-            for (uint8_t v = 0; v < 8; v++) {
-                fen << fenRank[7 - v];
-                if (v != 7) fen << '/';
+                if (e != 0) buffer[n++] = static_cast<char>('0' + e);
+                if (v != 0) buffer[n++] = '/';
             }
 
-            fen << ' ';
-            fen << (ColorToMove() == White ? 'w' : 'b');
-            fen << ' ';
+            buffer[n++] = ' ';
+            buffer[n++] = ColorToMove() == White ? 'w' : 'b';
+            buffer[n++] = ' ';
 
             if     (CastlingRightAndColorToMove &     CastlingMask) {
-                if (CastlingRightAndColorToMove & WhiteKCastleMask) fen << 'K';
-                if (CastlingRightAndColorToMove & WhiteQCastleMask) fen << 'Q';
-                if (CastlingRightAndColorToMove & BlackKCastleMask) fen << 'k';
-                if (CastlingRightAndColorToMove & BlackQCastleMask) fen << 'q';
-            } else fen << '-';
-
-            fen << ' ';
-            if (EnPassantSquare() != NASQ) fen << ToString(ToSquare(EnPassantTarget));
-            else fen << '-';
+                if (CastlingRightAndColorToMove & WhiteKCastleMask) buffer[n++] = 'K';
+                if (CastlingRightAndColorToMove & WhiteQCastleMask) buffer[n++] = 'Q';
+                if (CastlingRightAndColorToMove & BlackKCastleMask) buffer[n++] = 'k';
+                if (CastlingRightAndColorToMove & BlackQCastleMask) buffer[n++] = 'q';
+            } else buffer[n++] = '-';
+
+            buffer[n++] = ' ';
+            if (const Square epSq = EnPassantSquare(); epSq != NASQ) {
+                buffer[n++] = static_cast<char>(tolower(File(epSq)));
+                buffer[n++] = Rank(epSq);
+            } else buffer[n++] = '-';
 
             // Implement half and full move clocks.
-            fen << ' ';
-            fen << '0';
-            fen << ' ';
-            fen << '1';
+            buffer[n++] = ' ';
+            buffer[n++] = '0';
+            buffer[n++] = ' ';
+            buffer[n++] = '1';
 
-            return fen.str();
+            return n;
+        }
+
+        std::string Fen() const
+        {
+            FenBuffer buffer;
+
+            return { buffer.data(), Fen(buffer) };
         }
 
         ZobristHash Zobrist() const
@@ -273,6 +304,33 @@ namespace StockDory
             return Hash;
         }
 
+        ZobristHash PawnZobrist() const
+        {
+            return PawnHash;
+        }
+
+        uint8_t PieceCount(const Piece p) const
+        {
+            assert(p != NAP);
+
+            return PieceCounts[p];
+        }
+
+        uint8_t PieceCount() const
+        {
+            return TotalPieceCount;
+        }
+
+        uint16_t Material() const
+        {
+            return TotalMaterial;
+        }
+
+        uint16_t WeightedMaterial() const
+        {
+            return TotalWeightedMaterial;
+        }
+
         PieceColor operator [](const Square sq) const
         {
             return PieceAndColor[sq];
@@ -280,16 +338,23 @@ namespace StockDory
 
         BitBoard operator [](const Color c) const
         {
+            if (c == NAC) return ~Occupied();
+
             return ColorBB[c];
         }
 
+        BitBoard Occupied() const
+        {
+            return ColorBB[White] | ColorBB[Black];
+        }
+
         template<Color Color>
         BitBoard PieceBoard(const Piece p) const
         {
             assert(p != NAP);
             assert(Color != NAC);
 
-            return BB[Color][p];
+            return PieceBB[p] & ColorBB[Color];
         }
 
         [[nodiscard]]
@@ -298,7 +363,7 @@ namespace StockDory
             assert(p != NAP);
             assert(c != NAC);
 
-            return BB[c][p];
+            return PieceBB[p] & ColorBB[c];
         }
 
         Color ColorToMove() const
@@ -339,24 +404,24 @@ namespace StockDory
         {
             constexpr Color by = Opposite(We);
 
-            const Square king = ToSquare(BB[We][King]);
+            const Square king = ToSquare(PieceBoard(King, We));
 
-            if (AttackTable::Pawn[We][king] & BB[by][Pawn]) return true;
+            if (AttackTable::Pawn[We][king] & PieceBoard(Pawn, by)) return true;
 
-            if (AttackTable::Knight[king] & BB[by][Knight]) return true;
+            if (AttackTable::Knight[king] & PieceBoard(Knight, by)) return true;
 
-            const BitBoard occupied = ~ColorBB[NAC];
-            const BitBoard queen    = BB[by][Queen];
+            const BitBoard occupied = Occupied();
+            const BitBoard queen    = PieceBB[Queen];
 
             if (AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, king, occupied)] &
-                (queen | BB[by][Bishop]))
+                (queen | PieceBB[Bishop]) & ColorBB[by])
                 return true;
 
             if (AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook  , king, occupied)] &
-                (queen | BB[by][ Rook ]))
+                (queen | PieceBB[ Rook ]) & ColorBB[by])
                 return true;
 
-            return AttackTable::King[king] & BB[by][King];
+            return AttackTable::King[king] & PieceBoard(King, by);
         }
 
         template<Color By>
@@ -365,11 +430,11 @@ namespace StockDory
             uint8_t count = 0;
             auto    check = CheckBitBoard();
 
-            const Square sq = ToSquare(BB[Opposite(By)][King]);
+            const Square sq = ToSquare(PieceBoard(King, Opposite(By)));
 
             // Check if the square is under attack by opponent knights or pawns.
-            const BitBoard pawnCheck   = AttackTable::Pawn[Opposite(By)][sq] & BB[By][Pawn];
-            const BitBoard knightCheck = AttackTable::Knight[sq] & BB[By][Knight];
+            const BitBoard pawnCheck   = AttackTable::Pawn[Opposite(By)][sq] & PieceBoard(Pawn, By);
+            const BitBoard knightCheck = AttackTable::Knight[sq] & PieceBoard(Knight, By);
 
             // If the square is under attack by a pawn or knight, add it our checks.
             check.Check |= pawnCheck;
@@ -381,20 +446,20 @@ namespace StockDory
 
             // Check if the square is under attack by opponent bishops, rooks, or queens.
             // For queen, we can merge with checks for bishop and rook.
-            const BitBoard queen = BB[By][Queen];
+            const BitBoard queen = PieceBB[Queen];
 
             // All the occupied squares:
-            const BitBoard occupied = ~ColorBB[NAC];
+            const BitBoard occupied = Occupied();
 
             // Check if the square is under attack by opponent bishops or queens (diagonally).
             const BitBoard diagonalCheck =
                     AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, sq, occupied)] &
-                    (queen | BB[By][Bishop]);
+                    (queen | PieceBB[Bishop]) & ColorBB[By];
 
             // Check if the square is under attack by opponent rooks or queens (straight).
             const BitBoard straightCheck =
                     AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook, sq, occupied)] &
-                    (queen | BB[By][Rook]);
+                    (queen | PieceBB[ Rook ]) & ColorBB[By];
 
             // For sliding attacks, we must add the square of the attack's origin and all the squares to us from the
             // attack:
@@ -426,24 +491,24 @@ namespace StockDory
         {
             auto pin = PinBitBoard();
 
-            const Square sq = ToSquare(BB[We][King]);
+            const Square sq = ToSquare(PieceBoard(King, We));
 
             // All the occupied squares:
             // In this case, we want to let the pins pass through our pieces, since our pieces can move on the pins.
             const BitBoard occupied = ColorBB[By];
 
             // For queen, we can merge with checks for bishop and rook.
-            const BitBoard queen = BB[By][Queen];
+            const BitBoard queen = PieceBB[Queen];
 
             // Check if the square is under attack by opponent bishops or queens (diagonally).
             const BitBoard diagonalCheck =
                     AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, sq, occupied)] &
-                    (queen | BB[By][Bishop]);
+                    (queen | PieceBB[Bishop]) & ColorBB[By];
 
             // Check if the square is under attack by opponent rooks or queens (straight).
             const BitBoard straightCheck =
                     AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook, sq, occupied)] &
-                    (queen | BB[By][Rook]);
+                    (queen | PieceBB[ Rook ]) & ColorBB[By];
 
             // Iterate through the attacks and check if the attack is a diagonally pinning one.
             BitBoardIterator iterator(diagonalCheck);
@@ -460,18 +525,106 @@ namespace StockDory
             return pin;
         }
 
+        template<Color We>
+        AttackRecord Attacks(const CheckBitBoard& check) const
+        {
+            constexpr Color them = Opposite(We);
+
+            AttackRecord record;
+
+            record.Pin   = Pin<We, them>();
+            record.Check = check;
+
+            const Square king = ToSquare(PieceBoard(King, them));
+
+            const BitBoard occupied = Occupied();
+
+            // A piece checks the opponent's king from the squares it would be attacked from by the same piece (of the
+            // opposite color in the case of pawns)
+            const BitBoard diagonal = AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, king, occupied)];
+            const BitBoard straight = AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook  , king, occupied)];
+
+            record.CheckSquares[Pawn  ] = AttackTable::Pawn[them][king];
+            record.CheckSquares[Knight] = AttackTable::Knight    [king];
+            record.CheckSquares[Bishop] = diagonal;
+            record.CheckSquares[Rook  ] = straight;
+            record.CheckSquares[Queen ] = diagonal | straight;
+
+            // Our sliders are found by letting the rays pass through our pieces, and the pieces on a ray are only
+            // discoverers if they are the only piece between the slider and the opponent's king
+            const BitBoard queen = PieceBB[Queen];
+
+            BitBoard sliders =
+                AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, king, ColorBB[them])] &
+                (queen | PieceBB[Bishop]) & ColorBB[We] |
+                AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook  , king, ColorBB[them])] &
+                (queen | PieceBB[ Rook ]) & ColorBB[We];
+
+            BitBoardIterator iterator (sliders);
+            for (Square sq = iterator.Value(); sq != NASQ; sq = iterator.Value())
+                if (const BitBoard between = RayTable::Between[king][sq] & occupied; Count(between) == 1)
+                    record.Discoverers |= between;
+
+            return record;
+        }
+
+        template<Color We>
+        bool GivesCheck(const AttackRecord& attacks, const Square from, const Square to,
+                        const Piece promotion = NAP) const
+        {
+            const Piece  piece = PieceAndColor[from].Piece();
+            const Square king  = ToSquare(PieceBoard(King, Opposite(We)));
+
+            const BitBoard fromBB = FromSquare(from);
+            const BitBoard   toBB = FromSquare(  to);
+
+            BitBoard occupied = Occupied() ^ fromBB | toBB;
+            BitBoard diagonal = (PieceBB[Queen] | PieceBB[Bishop]) & ColorBB[We] & ~fromBB;
+            BitBoard straight = (PieceBB[Queen] | PieceBB[ Rook ]) & ColorBB[We] & ~fromBB;
+
+            if (promotion != NAP) {
+                // The promoted piece may check through the square the pawn just left, so the check squares can't be
+                // used here
+                if (promotion == Knight && AttackTable::Knight[to] & PieceBoard(King, Opposite(We))) return true;
+
+                if (promotion == Bishop || promotion == Queen) diagonal |= toBB;
+                if (promotion == Rook   || promotion == Queen) straight |= toBB;
+            } else if (piece == Pawn && toBB == EnPassantTarget) {
+                if (attacks.CheckSquares[Pawn] & toBB) return true;
+
+                occupied ^= FromSquare(static_cast<Square>(to ^ 8));
+            } else if (piece == King && (to > from ? to - from : from - to) == 2) {
+                // Castling moves the rook next to the king's destination, on the side of the king's origin
+                const auto rookFrom = static_cast<Square>(to > from ? to + 1 : to - 2);
+                const auto rookTo   = static_cast<Square>(to > from ? to - 1 : to + 1);
+
+                occupied ^= FromSquare(rookFrom) | FromSquare(rookTo);
+                straight ^= FromSquare(rookFrom) | FromSquare(rookTo);
+            } else {
+                if (attacks.CheckSquares[piece] & toBB) return true;
+
+                if (!(attacks.Discoverers & fromBB)) return false;
+            }
+
+            // Discovered checks (and checks by a promoted piece or a castled rook) are found by looking for our
+            // sliders from the opponent's king after the move
+            if (AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, king, occupied)] & diagonal) return true;
+
+            return AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook, king, occupied)] & straight;
+        }
+
         BitBoard SquareAttackers(const Square sq, const BitBoard occ) const
         {
-            BitBoard attackers = AttackTable::Pawn[White][sq] &  BB[Black][ Pawn ] |
-                                 AttackTable::Pawn[Black][sq] &  BB[White][ Pawn ] |
-                                 AttackTable::Knight     [sq] & (BB[White][Knight] | BB[Black][Knight]) |
-                                 AttackTable::King       [sq] & (BB[White][ King ] | BB[Black][ King ]) ;
+            BitBoard attackers = AttackTable::Pawn[White][sq] & PieceBB[ Pawn ] & ColorBB[Black] |
+                                 AttackTable::Pawn[Black][sq] & PieceBB[ Pawn ] & ColorBB[White] |
+                                 AttackTable::Knight     [sq] & PieceBB[Knight]                  |
+                                 AttackTable::King       [sq] & PieceBB[ King ]                  ;
 
             attackers |= AttackTable::Sliding[BlackMagicFactory::MagicIndex(Bishop, sq, occ)] &
-                    (BB[White][Bishop] | BB[Black][Bishop] | BB[White][Queen] | BB[Black][Queen]);
+                    (PieceBB[Bishop] | PieceBB[Queen]);
 
             attackers |= AttackTable::Sliding[BlackMagicFactory::MagicIndex(Rook, sq, occ)] &
-                    (BB[White][ Rook ] | BB[Black][ Rook ] | BB[White][Queen] | BB[Black][Queen]);
+                    (PieceBB[ Rook ] | PieceBB[Queen]);
 
             return attackers;
         }
@@ -500,14 +653,48 @@ namespace StockDory
             Hash = Zobrist::HashColorFlip<ZOBRIST>(Hash);
         }
 
+        MoveFlag Flag(const Piece piece, const Square from, const Square to) const
+        {
+            // The kind of move the given piece makes, which making the move would otherwise have to work out again
+            if (piece == Pawn) {
+                if (to == EnPassantSquare()              ) return EnPassantFlag ;
+                if (static_cast<Square>(from ^ 16) == to) return DoublePushFlag;
+            } else if (piece == King && (to > from ? to - from : from - to) == 2) return CastlingFlag;
+
+            return NoFlag;
+        }
+
+        InternalMove Extend(const Square from, const Square to, const Piece promotion = NAP) const
+        {
+            const Piece piece    = PieceAndColor[from].Piece();
+            const Piece captured = PieceAndColor[ to ].Piece();
+
+            return { from, to, promotion, piece, captured, Flag(piece, from, to) };
+        }
+
         template<MoveType T>
         PreviousState Move(const Square from, const Square to, const Piece promotion = NAP, const size_t threadId = 0)
+        {
+            return Move<T>(Extend(from, to, promotion), threadId);
+        }
+
+        template<MoveType T>
+        PreviousState Move(const InternalMove move, const size_t threadId = 0)
         {
             if (T & NNUE) Evaluation::PreMove(threadId);
 
-            auto state = PreviousState(PieceAndColor[from], PieceAndColor[to],
+            const Square from      = move.From();
+            const Square to        = move.To();
+            const Piece  promotion = move.Promotion();
+
+            const Piece pieceF = move.Piece();
+            const Color colorF = ColorToMove();
+            const Piece pieceT = move.Captured();
+            const Color colorT = pieceT == NAP ? NAC : Opposite(colorF);
+
+            auto state = PreviousState(PieceColor(pieceF, colorF), PieceColor(pieceT, colorT),
                                        EnPassantSquare(), CastlingRightAndColorToMove,
-                                       Hash);
+                                       Hash, PawnHash);
 
             Hash            = Zobrist::HashEnPassant<T>(Hash, EnPassantSquare());
             EnPassantTarget = BBDefault;
@@ -517,11 +704,6 @@ namespace StockDory
 
             Hash = Zobrist::HashCastling<T>(Hash, CastlingRightAndColorToMove & CastlingMask);
 
-            const Piece pieceF = state.MovedPiece.Piece();
-            const Color colorF = state.MovedPiece.Color();
-            const Piece pieceT = state.CapturedPiece.Piece();
-            const Color colorT = state.CapturedPiece.Color();
-
             using RookCastlingHandler = std::array<std::array<std::array<uint8_t, 64>, 2>, 2>;
             constexpr static RookCastlingHandler RookCastlingMask =
             [] constexpr -> RookCastlingHandler
@@ -550,23 +732,24 @@ namespace StockDory
             ][from];
 
             if (pieceF == Pawn) {
-                if (to == state.EnPassant) {
+                if (move.EnPassant()) {
                     const Color opposite = Opposite(colorF);
 
                     const auto epPawnSq = static_cast<Square>(state.EnPassant ^ 8);
                     EmptyNative(Pawn, opposite, epPawnSq);
-                    Hash = Zobrist::HashPiece<T>(Hash, Pawn, opposite, epPawnSq);
+                    Hash     = Zobrist::HashPiece<T>(    Hash, Pawn, opposite, epPawnSq);
+                    PawnHash = Zobrist::HashPawn <T>(PawnHash, Pawn, opposite, epPawnSq);
 
                     if (T & NNUE) Evaluation::Deactivate(Pawn, opposite, epPawnSq, threadId);
 
                     state.EnPassantCapture = true;
-                } else if (static_cast<Square>(from ^ 16) == to) {
+                } else if (move.DoublePush()) {
                     const auto epSq = static_cast<Square>(to ^ 8);
                     if (T & PERFT) {
                         EnPassantTarget = FromSquare(epSq);
                         Hash            = Zobrist::HashEnPassant<T>(Hash, epSq);
                     } else {
-                        if (AttackTable::Pawn[colorF][epSq] & BB[Opposite(colorF)][Pawn]) {
+                        if (AttackTable::Pawn[colorF][epSq] & PieceBoard(Pawn, Opposite(colorF))) {
                             EnPassantTarget = FromSquare(epSq);
                             Hash            = Zobrist::HashEnPassant<T>(Hash, epSq);
                         }
@@ -574,8 +757,9 @@ namespace StockDory
                 } else if (promotion != NAP) {
                     state.PromotedPiece = promotion;
 
+                    if (pieceT != NAP) EmptyNative(pieceT, colorT, to);
+
                      EmptyNative(Pawn     , colorF, from);
-                     EmptyNative(pieceT   , colorT,   to);
                     InsertNative(promotion, colorF,   to);
 
                     if (T & NNUE) {
@@ -589,6 +773,8 @@ namespace StockDory
                     Hash = Zobrist::HashPiece<T>(Hash, pieceT, colorT, to);
                     Hash = Zobrist::HashPiece<T>(Hash, promotion, colorF, to);
 
+                    PawnHash = Zobrist::HashPawn<T>(PawnHash, Pawn, colorF, from);
+
                     Hash = Zobrist::HashCastling<T>(Hash, CastlingRightAndColorToMove & CastlingMask);
 
                     return state;
@@ -596,7 +782,7 @@ namespace StockDory
             } else if (pieceF == King && CastlingRightAndColorToMove & ColorCastleMask[colorF]) {
                 CastlingRightAndColorToMove &= ~ColorCastleMask[colorF];
 
-                if (to == C1 || to == C8 || to == G1 || to == G8) {
+                if (move.Castling()) {
                     constexpr static std::array<std::array<Square, 2>, 2> RookCastleSquareStart {{
                         {H1, A1},
                         {H8, A8}
@@ -643,6 +829,10 @@ namespace StockDory
             Hash = Zobrist::HashPiece<T>(Hash, pieceT, colorT,   to);
             Hash = Zobrist::HashPiece<T>(Hash, pieceF, colorF,   to);
 
+            PawnHash = Zobrist::HashPawn<T>(PawnHash, pieceF, colorF, from);
+            PawnHash = Zobrist::HashPawn<T>(PawnHash, pieceT, colorT,   to);
+            PawnHash = Zobrist::HashPawn<T>(PawnHash, pieceF, colorF,   to);
+
             Hash = Zobrist::HashCastling<T>(Hash, CastlingRightAndColorToMove & CastlingMask);
 
             return state;
@@ -654,7 +844,10 @@ namespace StockDory
             if (T & NNUE) Evaluation::PreUndoMove(threadId);
 
             CastlingRightAndColorToMove = state.CastlingRightAndColorToMove;
-            if (T & ZOBRIST) Hash = state.Hash;
+            if (T & ZOBRIST) {
+                Hash     = state.Hash;
+                PawnHash = state.PawnHash;
+            }
 
             if (state.EnPassant != NASQ) EnPassantTarget = FromSquare(state.EnPassant);
             else EnPassantTarget                         = BBDefault;
@@ -682,18 +875,21 @@ namespace StockDory
                         const Piece pT, const Color cT, const Square sqT)
         {
             // Capture Section:
-            Set<false>(BB[cT][pT] , sqT);
-
-            Set<false>(ColorBB[cT], sqT);
+            if (pT != NAP) {
+                Set<false>(PieceBB[pT], sqT);
+                Set<false>(ColorBB[cT], sqT);
+
+                PieceCounts[pT]--;
+                TotalPieceCount--;
+                TotalMaterial         -= MaterialValue        [pT];
+                TotalWeightedMaterial -= MaterialScalingWeight[pT];
+            }
 
             // MoveNative Section:
-            Set<false>(BB[cF][pF], sqF);
-            Set<true >(BB[cF][pF], sqT);
-
-            Set<false>(ColorBB[cF], sqF);
-            Set<true >(ColorBB[cF], sqT);
+            const BitBoard fromTo = FromSquare(sqF) | FromSquare(sqT);
 
-            UpdateNACBB();
+            PieceBB[pF] ^= fromTo;
+            ColorBB[cF] ^= fromTo;
 
             PieceAndColor[sqT] = PieceAndColor[sqF];
             PieceAndColor[sqF] = PieceColor(NAP, NAC);
@@ -701,31 +897,30 @@ namespace StockDory
 
         void EmptyNative(const Piece p, const Color c, const Square sq)
         {
-            Set<false>(BB[c][p]  , sq);
-
+            Set<false>(PieceBB[p], sq);
             Set<false>(ColorBB[c], sq);
 
-            UpdateNACBB();
+            PieceCounts[p]--;
+            TotalPieceCount--;
+            TotalMaterial         -= MaterialValue        [p];
+            TotalWeightedMaterial -= MaterialScalingWeight[p];
 
             PieceAndColor[sq] = PieceColor(NAP, NAC);
         }
 
         void InsertNative(const Piece p, const Color c, const Square sq)
         {
-            Set<true>(BB[c][p]  , sq);
-
+            Set<true>(PieceBB[p], sq);
             Set<true>(ColorBB[c], sq);
 
-            UpdateNACBB();
+            PieceCounts[p]++;
+            TotalPieceCount++;
+            TotalMaterial         += MaterialValue        [p];
+            TotalWeightedMaterial += MaterialScalingWeight[p];
 
             PieceAndColor[sq] = PieceColor(p, c);
         }
 
-        void UpdateNACBB()
-        {
-            ColorBB[NAC] = ~(ColorBB[White] | ColorBB[Black]);
-        }
-
     };
 
 } // StockDory
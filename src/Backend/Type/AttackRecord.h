@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_ATTACKRECORD_H
+#define STOCKDORY_ATTACKRECORD_H
+
+#include <array>
+
+#include "BitBoard.h"
+#include "CheckBitBoard.h"
+#include "PinBitBoard.h"
+
+struct AttackRecord
+{
+
+    // The pins on and the checks against the side to move, as needed for move generation
+    PinBitBoard   Pin   ;
+    CheckBitBoard Check ;
+
+    // The squares each piece of the side to move would check the opponent's king from, and the pieces of the side to
+    // move that are the only blocker between one of its sliders and the opponent's king
+    std::array<BitBoard, 6> CheckSquares {};
+    BitBoard                Discoverers  = BBDefault;
+
+};
+
+#endif //STOCKDORY_ATTACKRECORD_H
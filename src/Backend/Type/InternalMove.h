@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_INTERNALMOVE_H
+#define STOCKDORY_INTERNALMOVE_H
+
+#include <cstdint>
+
+#include "Move.h"
+#include "Piece.h"
+#include "Square.h"
+
+using MoveFlag = uint8_t;
+
+constexpr MoveFlag NoFlag         = 0x0;
+constexpr MoveFlag EnPassantFlag  = 0x1;
+constexpr MoveFlag DoublePushFlag = 0x2;
+constexpr MoveFlag CastlingFlag   = 0x4;
+
+// The move as the generator knows it, carrying what making the move would otherwise have to look up on the board. The
+// 16-bit move remains the format moves are stored in (transposition table, PV, killers, history)
+struct InternalMove
+{
+
+    private:
+    constexpr static uint32_t   SquareMask = 0x003F;
+    constexpr static uint32_t   NibbleMask = 0x000F;
+    constexpr static uint8_t         ToPos =      6;
+    constexpr static uint8_t  PromotionPos =     12;
+    constexpr static uint8_t      PiecePos =     16;
+    constexpr static uint8_t   CapturedPos =     20;
+    constexpr static uint8_t       FlagPos =     24;
+
+    // The lower 16 bits are laid out the same way as the 16-bit move
+    // [    FLAG    ] [  CAPTURED  ] [   PIECE    ] [    PROMOTION    ] [     TO     ] [    FROM    ]
+    // [   4 BITS   ] [   4 BITS   ] [   4 BITS   ] [     4 BITS      ] [   6 BITS   ] [   6 BITS   ]
+    uint32_t Internal;
+
+    public:
+    constexpr InternalMove()
+    {
+        Internal = 0;
+    }
+
+    constexpr InternalMove(const Square from, const Square to, const enum Piece promotion,
+                           const enum Piece piece, const enum Piece captured, const MoveFlag flag = NoFlag)
+    {
+        Internal = from | to << ToPos | promotion << PromotionPos |
+                   piece << PiecePos | captured << CapturedPos | flag << FlagPos;
+    }
+
+    [[nodiscard]]
+    constexpr Square From() const
+    {
+        return static_cast<Square>(Internal & SquareMask);
+    }
+
+    [[nodiscard]]
+    constexpr Square To() const
+    {
+        return static_cast<Square>(Internal >> ToPos & SquareMask);
+    }
+
+    [[nodiscard]]
+    constexpr enum Piece Promotion() const
+    {
+        return static_cast<enum Piece>(Internal >> PromotionPos & NibbleMask);
+    }
+
+    // The piece being moved
+    [[nodiscard]]
+    constexpr enum Piece Piece() const
+    {
+        return static_cast<enum Piece>(Internal >> PiecePos & NibbleMask);
+    }
+
+    // The piece on the destination square (none for en passant, which is flagged instead)
+    [[nodiscard]]
+    constexpr enum Piece Captured() const
+    {
+        return static_cast<enum Piece>(Internal >> CapturedPos & NibbleMask);
+    }
+
+    [[nodiscard]]
+    constexpr bool EnPassant() const
+    {
+        return Internal >> FlagPos & EnPassantFlag;
+    }
+
+    [[nodiscard]]
+    constexpr bool DoublePush() const
+    {
+        return Internal >> FlagPos & DoublePushFlag;
+    }
+
+    [[nodiscard]]
+    constexpr bool Castling() const
+    {
+        return Internal >> FlagPos & CastlingFlag;
+    }
+
+    [[nodiscard]]
+    constexpr ::Move Move() const
+    {
+        return ::Move(From(), To(), Promotion());
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(const ::Move other) const
+    {
+        return Move() == other;
+    }
+
+    // ReSharper disable once CppNonExplicitConversionOperator
+    constexpr operator ::Move() const { return Move(); }
+
+    [[nodiscard]]
+    std::string ToString() const
+    {
+        return Move().ToString();
+    }
+
+};
+
+#endif //STOCKDORY_INTERNALMOVE_H
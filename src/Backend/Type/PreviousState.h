@@ -23,10 +23,11 @@ struct PreviousState
     uint8_t    CastlingRightAndColorToMove;
 
     ZobristHash Hash;
+    ZobristHash PawnHash;
 
     constexpr PreviousState(const PieceColor  movedPiece, const PieceColor capturedPiece,
                             const Square      enPassant,  const uint8_t    castlingRightAndColorToMove,
-                            const ZobristHash hash)
+                            const ZobristHash hash,       const ZobristHash pawnHash)
     {
         MovedPiece                  = movedPiece;
         CapturedPiece               = capturedPiece;
@@ -38,7 +39,8 @@ struct PreviousState
         CastlingFrom     = NASQ;
         CastlingTo       = NASQ;
 
-        Hash = hash;
+        Hash     = hash;
+        PawnHash = pawnHash;
     }
 
 };
@@ -9,6 +9,7 @@
 #include <array>
 #include <cstdint>
 #include <sstream>
+#include <string_view>
 
 enum Square : uint8_t
 {
@@ -70,7 +71,7 @@ std::string ToString(const Square sq)
     return ss.str();
 }
 
-Square FromString(const std::string& s)
+Square FromString(const std::string_view s)
 {
     const uint8_t file = tolower(s[0]) - 97;
     const uint8_t rank = tolower(s[1]) - 49;
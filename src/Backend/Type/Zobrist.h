@@ -395,6 +395,13 @@ namespace StockDory::Zobrist
         return hash;
     }
 
+    template<MoveType T>
+    constexpr ZobristHash HashPawn(const ZobristHash hash, const Piece p, const Color c, const Square sq)
+    {
+        if (T & ZOBRIST && p == Pawn) return hash ^ PieceKey[c][p][sq];
+        return hash;
+    }
+
     template<MoveType T>
     constexpr ZobristHash HashCastling(const ZobristHash hash, const uint8_t castlingRight)
     {
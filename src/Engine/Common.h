@@ -33,12 +33,33 @@ namespace StockDory
 
     constexpr size_t CacheLineSize = 64;
 
+    // Whether the search saves and restores the board around every move (copy-make) instead of unmaking moves, as
+    // chosen at build time (BUILD_COPY_MAKE)
+#ifdef COPY_MAKE
+    constexpr bool CopyMake = true;
+#else
+    constexpr bool CopyMake = false;
+#endif
+
     using MS = std::chrono::milliseconds;
     using TP = std::chrono::time_point<std::chrono::steady_clock>;
 
     using KTable = Array<Move, 2, MaxDepth>;
     using HTable = Array<int16_t, 2, 6, 64>;
 
+    // Continuation history: indexed by the color to move, the piece and destination of an earlier move, and then the
+    // piece and destination of the current move
+    using CHTable = Array<int16_t, 2, 6, 64, 6, 64>;
+    using CHEntry = Array<int16_t,          6, 64>;
+
+    // Correction history: indexed by the color to move and a hash of the position
+    constexpr uint16_t CorrectionHistorySize = 16384;
+
+    using CRTable = Array<int16_t, 2, CorrectionHistorySize>;
+
+    // Capture history: indexed by the color to move, the moving piece, its destination, and the captured piece
+    using CPTable = Array<int16_t, 2, 6, 64, 6>;
+
     bool IsMate(const Score score) { return abs(score) >= MateInMaxDepth; }
 
     bool IsWin (const Score score) { return score >=  MateInMaxDepth; }
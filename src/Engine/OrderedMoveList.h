@@ -10,6 +10,8 @@
 #include <cassert>
 
 #include "../Backend/Move/MoveList.h"
+#include "../Backend/Type/AttackRecord.h"
+#include "../Backend/Type/InternalMove.h"
 #include "../Backend/Type/Move.h"
 
 #include "Common.h"
@@ -26,12 +28,12 @@ namespace StockDory
         struct OrderedMove
         {
 
-            uint32_t Score;
-            Move     Move ;
+            uint32_t     Score;
+            InternalMove Move ;
 
             OrderedMove() = default;
 
-            OrderedMove(const uint32_t score, const ::Move move) : Score(score), Move(move) {}
+            OrderedMove(const uint32_t score, const InternalMove move) : Score(score), Move(move) {}
 
             OrderedMove(const OrderedMove& other) : Score(other.Score), Move(other.Move) {}
 
@@ -45,16 +47,30 @@ namespace StockDory
         public:
         explicit OrderedMoveList(const Board & board , const uint8_t ply   ,
                                  const KTable& kTable, const HTable& hTable,
-                                 const Move    ttMove = {})
+                                 const Move    ttMove = {},
+                                 const CHEntry* counterMove = nullptr, const CHEntry* followUp = nullptr,
+                                 const CPTable* capture     = nullptr,
+                                 const AttackRecord* attacks = nullptr)
         {
             const Move kOne = kTable[0][ply];
             const Move kTwo = kTable[1][ply];
 
-            const Policy<Color, CaptureOnly> policy (kOne, kTwo, ttMove);
+            const Policy<Color, CaptureOnly> policy (kOne, kTwo, ttMove, counterMove, followUp, capture);
 
-            const PinBitBoard   pin   = board.Pin<Color, Opposite(Color)>();
+            // The search may have already worked out the pins and checks for this position
+            if (attacks) AddMoves(board, hTable, policy, attacks->Pin, attacks->Check);
+            else         AddMoves(board, hTable, policy, board.Pin<Color, Opposite(Color)>(),
+                                                         board.Check<Opposite(Color)>());
+        }
 
-            if (const CheckBitBoard check = board.Check<Opposite(Color)>(); check.DoubleCheck) {
+        private:
+        void AddMoves(const Board         &  board,
+                      const HTable        & hTable,
+                      const OrderingPolicy& policy,
+                      const PinBitBoard   &    pin,
+                      const CheckBitBoard &  check)
+        {
+            if (check.DoubleCheck) {
                 AddMoveLoop<King  >(board, hTable, policy, pin, check);
             } else {
                 AddMoveLoop<Pawn  >(board, hTable, policy, pin, check);
@@ -104,13 +120,14 @@ namespace StockDory
                                          const Square           from ,
                                          const Square            to  )
         {
-            const auto move = Move(from, to, Promotion);
+            // The generator already knows which piece is moving, so only the captured piece is looked up
+            const auto move = InternalMove(from, to, Promotion, Piece, board[to].Piece(), board.Flag(Piece, from, to));
             return { policy.template Score<Piece, Promotion>(board, hTable, move), move };
         }
 
         public:
         [[nodiscard]]
-        Move operator [](const uint8_t index)
+        InternalMove operator [](const uint8_t index)
         {
             assert(index < Size);
 
@@ -119,13 +136,29 @@ namespace StockDory
         }
 
         [[nodiscard]]
-        Move UnsortedAccess(const uint8_t index) const
+        InternalMove UnsortedAccess(const uint8_t index) const
         {
             assert(index < Size);
 
             return Internal[index].Move;
         }
 
+        template<typename Predicate>
+        void Retain(Predicate&& predicate)
+        {
+            uint8_t size = 0;
+
+            for (uint8_t i = 0; i < Size; i++) if (predicate(Internal[i].Move)) Internal[size++] = Internal[i];
+
+            Size = size;
+        }
+
+        template<typename Scorer>
+        void Rescore(Scorer&& scorer)
+        {
+            for (uint8_t i = 0; i < Size; i++) Internal[i].Score = scorer(Internal[i].Move, Internal[i].Score);
+        }
+
         [[nodiscard]]
         uint8_t Count() const
         {
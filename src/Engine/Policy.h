@@ -7,10 +7,12 @@
 #define STOCKDORY_POLICY_H
 
 #include "../Backend/Board.h"
+#include "../Backend/Type/InternalMove.h"
 #include "../Backend/Type/Move.h"
 
 #include "Common.h"
 #include "SEE.h"
+#include "TunableParameter.h"
 
 namespace StockDory
 {
@@ -48,11 +50,20 @@ namespace StockDory
 
         Move TTMove;
 
+        const CHEntry* CounterMoveHistory;
+        const CHEntry*    FollowUpHistory;
+
+        const CPTable* CaptureHistory;
+
         public:
-        Policy(const Move kOne, const Move kTwo, const Move tt) : KillerOne(kOne), KillerTwo(kTwo), TTMove(tt) {}
+        Policy(const Move kOne, const Move kTwo, const Move tt,
+               const CHEntry* counterMove = nullptr, const CHEntry* followUp = nullptr,
+               const CPTable* capture     = nullptr) :
+        KillerOne(kOne), KillerTwo(kTwo), TTMove(tt), CounterMoveHistory(counterMove), FollowUpHistory(followUp),
+        CaptureHistory(capture) {}
 
         template<Piece Piece, enum Piece PromotionPiece = NAP>
-        uint32_t Score(const Board& board, const HTable& history, const Move move) const
+        uint32_t Score(const Board& board, const HTable& history, const InternalMove move) const
         {
             // Policy:
             //
@@ -62,10 +73,10 @@ namespace StockDory
             //
             // - Transposition Table Move
             // - Promotions
-            // - Good Captures (SEE >= 0)
+            // - Good Captures (SEE >= 0, ordered by MVV-LVA and capture history)
             // - Good Quiet Moves
             //   - Killer Moves
-            //   - Good History Moves
+            //   - Good History Moves (including counter-move and follow-up history)
             // - Bad Captures (SEE < 0)
             // - Bad Quiet Moves
             //   - Bad History Moves
@@ -74,7 +85,7 @@ namespace StockDory
 
             constexpr bool Promotion = PromotionPiece != NAP;
 
-            const bool     capture = board[move.To()].Piece() != NAP;
+            const bool     capture = move.Captured() != NAP;
             const bool goodCapture = capture ? SEE::Accurate(board, move, 0) : false;
 
             uint32_t score = ScoreAnchor;
@@ -82,7 +93,11 @@ namespace StockDory
             if (Promotion) score += PromotionFactor[PromotionPiece] * PromotionMultiplier;
 
             if (CaptureOnly || capture) {
-                score += MvvLva[board[move.To()].Piece()][Piece] * (goodCapture ? 20 : 1);
+                score += MvvLva[move.Captured()][Piece] * (goodCapture ? 20 : 1);
+
+                if (CaptureHistory && capture)
+                    score += (*CaptureHistory)[Color][Piece][move.To()][move.Captured()] /
+                             CaptureHistoryPolicyPartition;
 
                 return score;
             }
@@ -90,7 +105,15 @@ namespace StockDory
             if (move == KillerOne) score += HistoryLimit    ;
             if (move == KillerTwo) score += HistoryLimit / 2;
 
-            score += history[Color][Piece][move.To()];
+            // The history tables are averaged over those available for this position, so the combined score stays in
+            // the range of a single table and the killer bonuses keep their standing against it
+            int32_t quiet  = history[Color][Piece][move.To()];
+            int32_t tables = 1;
+
+            if (CounterMoveHistory) { quiet += (*CounterMoveHistory)[Piece][move.To()]; tables++; }
+            if (   FollowUpHistory) { quiet += (*   FollowUpHistory)[Piece][move.To()]; tables++; }
+
+            score += quiet / tables;
 
             return score;
         }
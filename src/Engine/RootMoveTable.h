@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_ROOTMOVETABLE_H
+#define STOCKDORY_ROOTMOVETABLE_H
+
+#include <algorithm>
+
+#include "../Backend/Type/Move.h"
+
+#include "Common.h"
+
+namespace StockDory
+{
+
+    class RootMoveTable
+    {
+
+        struct RootMove
+        {
+
+            Move     Move               {};
+            uint64_t Nodes              = 0;
+            uint64_t PreviousNodes      = 0;
+            Score    Evaluation         = -Infinity;
+            Score    PreviousEvaluation = -Infinity;
+
+        };
+
+        Array<RootMove, MaxMove> Internal {};
+        uint8_t                  Size = 0;
+
+        uint64_t PreviousNodes = 0;
+
+        bool Ordered = false;
+
+        RootMove* Find(const Move move)
+        {
+            for (uint8_t i = 0; i < Size; i++) if (Internal[i].Move == move) return &Internal[i];
+
+            return nullptr;
+        }
+
+        const RootMove* Find(const Move move) const
+        {
+            for (uint8_t i = 0; i < Size; i++) if (Internal[i].Move == move) return &Internal[i];
+
+            return nullptr;
+        }
+
+        public:
+        void Clear()
+        {
+            Size          = 0;
+            PreviousNodes = 0;
+            Ordered       = false;
+        }
+
+        void Add(const Move move) { Internal[Size++] = { .Move = move }; }
+
+        uint8_t Count() const { return Size; }
+
+        Move First() const { return Internal[0].Move; }
+
+        void Update(const Move move, const uint64_t nodes, const Score evaluation)
+        {
+            RootMove* entry = Find(move);
+
+            if (entry == nullptr) return;
+
+            entry->Nodes      += nodes;
+            entry->Evaluation  = evaluation;
+        }
+
+        void Conclude(const Move best)
+        {
+            // Once an iteration is completed, the moves are ordered for the next iteration: the best move first,
+            // followed by the rest in order of how many nodes were spent on them - the more nodes a move took to
+            // refute, the closer it likely came to being the best move
+            std::stable_sort(Internal.begin(), Internal.begin() + Size,
+                [best](const RootMove& a, const RootMove& b) -> bool
+                {
+                    if (a.Move == best || b.Move == best) return a.Move == best && b.Move != best;
+
+                    return a.Nodes > b.Nodes;
+                }
+            );
+
+            PreviousNodes = 0;
+            for (uint8_t i = 0; i < Size; i++) {
+                RootMove& entry = Internal[i];
+
+                PreviousNodes += entry.Nodes;
+
+                entry.PreviousNodes      = entry.Nodes;
+                entry.PreviousEvaluation = entry.Evaluation;
+                entry.Nodes              = 0;
+            }
+
+            Ordered = true;
+        }
+
+        void Prioritize(const Move move)
+        {
+            // Moves the given move to the front of the table, ordering the rest as they were added
+            RootMove* entry = Find(move);
+
+            if (entry == nullptr) return;
+
+            const auto index = entry - Internal.data();
+
+            std::rotate(Internal.begin(), Internal.begin() + index, Internal.begin() + index + 1);
+
+            Ordered = true;
+        }
+
+        // Ordered root moves are scored above every score the move policy gives (other than the transposition table
+        // move's), leaving room above them for the mate search's check bonus
+        constexpr static uint32_t PriorityBase = 1U << 31;
+
+        uint32_t Priority(const Move move, const uint32_t fallback) const
+        {
+            // Until an iteration completes, the regular move policy orders the root moves
+            if (!Ordered) return fallback;
+
+            for (uint8_t i = 0; i < Size; i++)
+                if (Internal[i].Move == move) return PriorityBase - 1 - i;
+
+            return fallback;
+        }
+
+        double NodeShare(const Move move) const
+        {
+            const RootMove* entry = Find(move);
+
+            if (entry == nullptr || PreviousNodes == 0) return 0.0;
+
+            return static_cast<double>(entry->PreviousNodes) / static_cast<double>(PreviousNodes);
+        }
+
+        Score PreviousEvaluation(const Move move) const
+        {
+            const RootMove* entry = Find(move);
+
+            return entry == nullptr ? -Infinity : entry->PreviousEvaluation;
+        }
+
+    };
+
+} // StockDory
+
+#endif //STOCKDORY_ROOTMOVETABLE_H
@@ -6,7 +6,13 @@
 #ifndef STOCKDORY_SEARCH_H
 #define STOCKDORY_SEARCH_H
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "../Backend/Board.h"
 #include "../Backend/Misc.h"
@@ -15,6 +21,7 @@
 
 #include "Common.h"
 #include "OrderedMoveList.h"
+#include "RootMoveTable.h"
 #include "TranspositionTable.h"
 #include "TunableParameter.h"
 
@@ -62,6 +69,74 @@ namespace StockDory
 
     inline TranspositionTable<SearchTranspositionEntry> TT (16 * MB);
 
+    enum ParallelSearchMode : uint8_t
+    {
+
+        LazySMP,
+        ABDADA
+
+    };
+
+    inline ParallelSearchMode SMPMode = LazySMP;
+
+    // Counter-move and follow-up history (see the search) are opt-in, as with the current network the search
+    // needs more nodes to reach the same depth when they take part in move ordering and reductions
+    inline bool ContinuationHistory = false;
+
+    class SearchingMoveTable
+    {
+
+        // Relevant links:
+        // - https://www.chessprogramming.org/ABDADA
+        //
+        // A small table shared between all threads, marking the moves (position and move pairs) that are currently
+        // being searched by some thread. Entries are the keys themselves, so marking a move is a single store and
+        // checking a move is a single load and compare. Collisions only cause a move to not be deferred (or be
+        // deferred when it needn't be), which affects the search's efficiency but never its correctness
+
+        TranspositionTable<std::atomic<ZobristHash>> Internal { MB / 4 };
+
+        bool Active = false;
+
+        [[clang::always_inline]]
+        static ZobristHash Key(const ZobristHash hash, const Move move)
+        {
+            const uint64_t m = move.From() | move.To() << 6 | move.Promotion() << 12;
+
+            return hash ^ (m + 1) * 0x9E3779B97F4A7C15ULL;
+        }
+
+        public:
+        void Enable(const bool active) { Active = active; }
+
+        bool Enabled() const { return Active; }
+
+        bool Searching(const ZobristHash hash, const Move move) const
+        {
+            const ZobristHash key = Key(hash, move);
+
+            return Internal[key].load(std::memory_order_relaxed) == key;
+        }
+
+        void Mark(const ZobristHash hash, const Move move)
+        {
+            const ZobristHash key = Key(hash, move);
+
+            Internal[key].store(key, std::memory_order_relaxed);
+        }
+
+        void Unmark(const ZobristHash hash, const Move move)
+        {
+            ZobristHash key = Key(hash, move);
+
+            // Only clear the entry if it wasn't taken over by another move in the meantime
+            Internal[key].compare_exchange_strong(key, 0, std::memory_order_relaxed);
+        }
+
+    };
+
+    inline SearchingMoveTable SearchingMoves;
+
     inline auto LMRTable =
     [] -> Array<int32_t, MaxDepth, MaxMove>
     {
@@ -90,6 +165,13 @@ namespace StockDory
             Score   StaticEvaluation = None;
             uint8_t HalfMoveCounter  =    0;
 
+            // The piece moved and its destination by the move made from this ply (no piece for a null move)
+            Piece   MovedPiece       =  NAP;
+            Square  MovedTo          = NASQ;
+
+            // The move left out when searching this ply (for singular extensions), if any
+            Move    ExcludedMove     {};
+
         };
 
         private:
@@ -170,14 +252,120 @@ namespace StockDory
         uint64_t Nodes = std::numeric_limits<uint64_t>::max();
         uint8_t  Depth = MaxDepth / 2;
 
-        bool Timed = false;
-        bool Fixed = false;
+        bool Timed    = false;
+        bool Fixed    = false;
+        bool Infinite = false;
+
+        uint8_t MultiPV = 1;
+
+        // Searches for a mate within this many moves, stopping as soon as one is proven
+        uint8_t Mate = 0;
 
         MS ActualTime  {};
         MS OptimalTime {};
 
+        // Restricts the root moves searched to these moves, if any
+        std::vector<Move> SearchMoves {};
+
+    };
+
+    // Nodes are first counted locally by every search task and only flushed to the shared budget in batches, keeping
+    // the shared counter's cache line from bouncing between threads on every node
+    constexpr uint64_t NodeBudgetMaximumBatch = 1024;
+
+    class alignas(CacheLineSize) SearchNodeBudget
+    {
+
+        std::atomic<uint64_t> Searched  = 0;
+        std::atomic<bool>     Exhausted = false;
+
+        public:
+        void Reset()
+        {
+            Searched .store(0    , std::memory_order_relaxed);
+            Exhausted.store(false, std::memory_order_relaxed);
+        }
+
+        static uint64_t Batch(const uint64_t limit)
+        {
+            // Smaller budgets get smaller batches, so the budget is overshot by at most a small fraction of itself,
+            // regardless of how many threads are searching
+            return std::clamp<uint64_t>(limit / NodeBudgetMaximumBatch, 1, NodeBudgetMaximumBatch);
+        }
+
+        bool Flush(const uint64_t nodes, const uint64_t limit)
+        {
+            const uint64_t searched = Searched.fetch_add(nodes, std::memory_order_relaxed) + nodes;
+
+            if (searched > limit) Exhausted.store(true, std::memory_order_relaxed);
+
+            return Exhausted.load(std::memory_order_relaxed);
+        }
+
+        uint64_t Nodes() const { return Searched.load(std::memory_order_relaxed); }
+
+    };
+
+    inline SearchNodeBudget NodeBudget;
+
+    struct HelperDiversificationConfiguration
+    {
+
+        // Every helper thread searching the exact same tree as the main thread only adds transposition table entries
+        // the main thread was about to produce itself. Diversifying the depths the helpers search and the windows they
+        // search with makes them explore (and store) parts of the tree the main thread reaches later, if ever
+
+        bool    StartDepth         = true;
+        bool    SkipDepth          = true;
+        uint8_t WindowPerturbation = HelperWindowPerturbationMargin;
+
+    };
+
+    inline HelperDiversificationConfiguration HelperDiversification;
+
+    struct alignas(CacheLineSize) SearchThreadState
+    {
+
+        // The hot per-thread counters and state share a cache line of their own, so a thread counting nodes never
+        // invalidates the cache lines of its neighbours. Fields touched by more than one thread are atomics: the node
+        // count and finish flag are written only by the owning thread, while the status is also stopped by whichever
+        // thread ends the search, and the pondering fields are written by the interface thread. Those foreign writes
+        // happen a handful of times per search, so they are left on the owner's cache line instead of padded apart
+
+        std::atomic<uint64_t>           Nodes    = 0;
+        std::atomic<SearchThreadStatus> Status   = Running;
+        std::atomic<bool>               Finished = false;
+
+        // Set by the interface while the engine searches on the opponent's time, with the moment the opponent played
+        // the expected move (in steady clock ticks) recorded once it does
+        std::atomic<bool>              Pondering = false;
+        std::atomic<TP::rep>       PonderHitTime = 0;
+
+        uint64_t UnflushedNodes = 0;
+        uint64_t NodeBatch      = NodeBudgetMaximumBatch;
+
+        SearchThreadState() = default;
+
+        SearchThreadState(const SearchThreadState& other) { *this = other; }
+
+        SearchThreadState& operator =(const SearchThreadState& other)
+        {
+            Nodes   .store(other.Nodes   .load(std::memory_order_relaxed), std::memory_order_relaxed);
+            Status  .store(other.Status  .load(std::memory_order_relaxed), std::memory_order_relaxed);
+            Finished.store(other.Finished.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            Pondering    .store(other.Pondering    .load(std::memory_order_relaxed), std::memory_order_relaxed);
+            PonderHitTime.store(other.PonderHitTime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            UnflushedNodes = other.UnflushedNodes;
+            NodeBatch      = other.NodeBatch;
+
+            return *this;
+        }
+
     };
 
+
     class WDLCalculator
     {
 
@@ -202,17 +390,7 @@ namespace StockDory
         [[clang::always_inline]]
         static Coefficient Coefficient(const Board& board)
         {
-            const BitBoard pawn   = board.PieceBoard(Pawn  , White) | board.PieceBoard(Pawn  , Black);
-            const BitBoard knight = board.PieceBoard(Knight, White) | board.PieceBoard(Knight, Black);
-            const BitBoard bishop = board.PieceBoard(Bishop, White) | board.PieceBoard(Bishop, Black);
-            const BitBoard rook   = board.PieceBoard(Rook  , White) | board.PieceBoard(Rook  , Black);
-            const BitBoard queen  = board.PieceBoard(Queen , White) | board.PieceBoard(Queen , Black);
-
-            const Score mat = Count(pawn  ) * 1 +
-                              Count(knight) * 3 +
-                              Count(bishop) * 3 +
-                              Count(rook  ) * 5 +
-                              Count(queen ) * 9 ;
+            const Score mat = board.Material();
 
             return { Formula<A>(mat), Formula<B>(mat) };
         }
@@ -271,13 +449,41 @@ namespace StockDory
         uint64_t          Nodes {};
         MS                 Time {};
         PVEntry         PVEntry {};
+        uint8_t            Line { 1 };
+        uint8_t           Lines { 1 };
+
+    };
+
+    struct IterativeDeepeningResult
+    {
+
+        int16_t Depth      = 0;
+        Score   Evaluation = -Infinity;
+        Move    Move       {};
+        PVEntry PVEntry    {};
 
     };
 
     struct IterativeDeepeningCompletionEvent
     {
 
-        Move Move {};
+        Move   Move       {};
+        ::Move PonderMove {};
+
+    };
+
+    struct SearchTimeStatisticsEvent
+    {
+
+        int16_t           Depth {};
+        MS                 Time {};
+        MS          OptimalTime {};
+        MS             SoftTime {};
+        MS           ActualTime {};
+        uint8_t       Stability {};
+        double        NodeShare {};
+        Score   EvaluationDelta {};
+        uint16_t         Effort {};
 
     };
 
@@ -290,6 +496,9 @@ namespace StockDory
         static void HandleIterativeDeepeningCompletion(const IterativeDeepeningCompletionEvent& _)
         {}
 
+        static void HandleSearchTimeStatistics(const SearchTimeStatisticsEvent& _)
+        {}
+
     };
 
     template<SearchThreadType ThreadType = Main, class EventHandler = DefaultSearchEventHandler>
@@ -298,8 +507,18 @@ namespace StockDory
 
         Board Board {};
 
-        KTable Killer  {};
-        HTable History {};
+        // With copy-make, the board is saved before every move and restored afterwards instead of being unmade
+        Array<StockDory::Board, CopyMake ? MaxDepth : 0> BoardStack {};
+
+        KTable  Killer             {};
+        HTable  History            {};
+        CPTable CaptureHistory     {};
+        CRTable PawnCorrection     {};
+
+        // The continuation histories take over a megabyte together, so they are kept on the heap rather than making
+        // the task itself too large to be put on a stack
+        std::unique_ptr<CHTable> CounterMoveHistory = std::make_unique<CHTable>();
+        std::unique_ptr<CHTable> FollowUpHistory    = std::make_unique<CHTable>();
 
         SearchStack Stack {};
 
@@ -313,19 +532,35 @@ namespace StockDory
 
         int16_t IDepth = 0;
 
-        uint64_t Nodes = 0;
-
         Score Evaluation = -Infinity;
 
         Move BestMove {};
 
+        RootMoveTable RootMoves {};
+
+        // The move the previous search expected to be played in this position, if this search continues its line
+        Move ExpectedMove {};
+
+        // Multiple PVs: the line currently being searched, along with the moves heading and evaluations of every line
+        uint8_t                  PVLine = 0;
+        Array<Move , MaxMove>    LineMoves {};
+        Array<Score, MaxMove>    LineEvaluations {};
+
+        IterativeDeepeningResult Result {};
+
         TP StartTime = {};
 
         uint8_t SearchStability = 0;
 
+        // Scale (in percent) applied to the optimal time, determined by the effort spent on the best move and how
+        // volatile the evaluation is
+        uint16_t SearchEffort = 100;
+        double   SearchEffortNodeShare = 0.0;
+        Score    SearchEffortEvaluationDelta = 0;
+
         size_t ThreadId = 0;
 
-        SearchThreadStatus Status = Running;
+        SearchThreadState State {};
 
         public:
         SearchTask() {}
@@ -340,10 +575,102 @@ namespace StockDory
         : Board(board), Repetition(repetition), Limit(limit), ThreadId(threadId)
         {
             Stack[0].HalfMoveCounter = hmc;
+
+            State.NodeBatch = SearchNodeBudget::Batch(limit.Nodes);
         }
         // ReSharper restore CppPassValueParameterByConstReference
 
-        uint64_t GetNodes() const { return Nodes; }
+        uint64_t GetNodes() const { return State.Nodes.load(std::memory_order_relaxed); }
+
+        // The number of plies of this task's principal variation that lead to the given position, or zero if the
+        // principal variation doesn't lead to it
+        uint8_t Continuation(const StockDory::Board& board) const
+        {
+            if (Result.Depth == 0) return 0;
+
+            StockDory::Board line = Board;
+
+            const uint8_t length = std::min<uint8_t>(Result.PVEntry.Ply, ContinuationMaximumPly);
+            for (uint8_t ply = 0; ply < length; ply++) {
+                const Move move = Result.PVEntry.PV[ply];
+
+                line.Move<ZOBRIST>(move.From(), move.To(), move.Promotion());
+
+                if (line.Zobrist() == board.Zobrist()) return ply + 1;
+            }
+
+            return 0;
+        }
+
+        // Sets the task up for a new search in place, as the task is too large to be built for every search and
+        // copied into place
+        void Prepare(const StockDory::Limit& limit, const StockDory::Board& board, const RepetitionStack& repetition,
+                     const uint8_t hmc, const size_t threadId)
+        {
+            // Search State Reuse:
+            //
+            // If the position being searched was reached by following the principal variation of the previous search,
+            // most of what the previous search learned still applies. The history tables are position independent, so
+            // they are kept as is. The killer moves are indexed by ply, so they are shifted by the number of plies that
+            // were played. The move the previous search expected to be played in this position is searched first at
+            // the root, as it is very likely to still be the best move
+            if (const uint8_t plies = Continuation(board)) {
+                for (uint8_t ply = 0; ply < MaxDepth; ply++) {
+                    const bool kept = ply + plies < MaxDepth;
+
+                    Killer[0][ply] = kept ? Killer[0][ply + plies] : Move();
+                    Killer[1][ply] = kept ? Killer[1][ply + plies] : Move();
+                }
+
+                ExpectedMove = plies < Result.PVEntry.Ply ? Result.PVEntry.PV[plies] : Move();
+            } else Forget();
+
+            Board      = board;
+            Stack      = {};
+            Repetition = repetition;
+            PVTable    = {};
+            Limit      = limit;
+
+            Stack[0].HalfMoveCounter = hmc;
+
+            SelectiveDepth = 0;
+            IDepth         = 0;
+            Evaluation     = -Infinity;
+            BestMove       = {};
+            RootMoves      = {};
+
+            PVLine          = 0;
+            LineMoves       = {};
+            LineEvaluations = {};
+
+            Result    = {};
+            StartTime = {};
+
+            SearchStability             = 0;
+            SearchEffort                = 100;
+            SearchEffortNodeShare       = 0.0;
+            SearchEffortEvaluationDelta = 0;
+
+            ThreadId = threadId;
+
+            State           = {};
+            State.NodeBatch = SearchNodeBudget::Batch(limit.Nodes);
+        }
+
+        // Forgets everything the previous search learned, so that the next search starts from scratch
+        void Forget()
+        {
+            Killer         = {};
+            History        = {};
+            CaptureHistory = {};
+            PawnCorrection = {};
+
+            std::memset(CounterMoveHistory.get(), 0, sizeof(CHTable));
+            std::memset(FollowUpHistory   .get(), 0, sizeof(CHTable));
+
+            ExpectedMove = {};
+            Result       = {};
+        }
 
         void IterativeDeepening()
         {
@@ -352,82 +679,309 @@ namespace StockDory
                 // case, we can save time by searching far less (ideally just a few depths) - saving time for when we
                 // have more choices
                 SearchSingleMoveTimeOptimization();
-
-                // Set the starting point for all time measurements
-                StartTime = std::chrono::steady_clock::now();
             }
 
+            // Set the starting point for all time measurements
+            StartTime = std::chrono::steady_clock::now();
+
             // Load the board state for evaluation purposes (this needs to be done for all threads with their respective
             // thread IDs as each thread has its own evaluation state)
             Board.LoadForEvaluation(ThreadId);
 
-            IDepth = 1;
-            while (IDepth <= Limit.Depth && !OutOfTime<Limit::Optimal>()) {
-                const Move lastBestMove = BestMove;
+            if (Board.ColorToMove() == White) InitializeRootMoves<White>();
+            else                              InitializeRootMoves<Black>();
+
+            // There can't be more lines than there are root moves to head them
+            const uint8_t lines = std::min<uint8_t>(Limit.MultiPV, RootMoves.Count());
+
+            LineEvaluations.fill(-Infinity);
 
-                if (Board.ColorToMove() ==   White)
-                     Evaluation = Aspiration<White>(IDepth);
-                else Evaluation = Aspiration<Black>(IDepth);
+            // The principal variation of every line found in an iteration, kept until the lines are reported
+            std::vector<PVEntry> linePVs (lines);
 
-                // In the case that the search was stopped, we should just proceed to fire the completion event
-                if (Status == SearchThreadStatus::Stopped) break;
+            // Only the main thread keeps track of time, the helper threads keep searching until the main thread stops
+            // them
+            IDepth = StartDepth();
+            while (IDepth <= Limit.Depth && (ThreadType == Parallel || !OutOfTime<Limit::Optimal>())) {
+                if (SkipDepth()) {
+                    IDepth++;
+                    continue;
+                }
+
+                const Move  lastBestMove   = BestMove;
+                const Score lastEvaluation = Evaluation;
+
+                // Multiple Principal Variations (MultiPV):
+                //
+                // Each iteration searches the requested number of lines one after another, every line excluding the
+                // root moves heading the lines found before it in this iteration - making each line the best line
+                // among the remaining root moves. The lines share the transposition table and move ordering, so the
+                // later lines are much cheaper to search than a separate search would be
+                uint8_t found = 0;
+                for (PVLine = 0; PVLine < lines; PVLine++) {
+                    const Score evaluation = Board.ColorToMove() == White ? Aspiration<White>(IDepth)
+                                                                          : Aspiration<Black>(IDepth);
+
+                    // In the case that the search was stopped, we should just proceed to fire the completion event
+                    if (Stopped()) break;
+
+                    // A mate search that failed low only knows that there is no mate at this depth, which is neither a
+                    // result nor worth reporting. The lines after it would only have fewer root moves to find one with
+                    if (Limit.Mate && evaluation < WinIn(MatePly())) break;
+
+                    LineMoves      [PVLine] = PVTable[0].PV[0];
+                    LineEvaluations[PVLine] = evaluation;
+                    linePVs        [PVLine] = PVTable[0];
+
+                    // Line Ordering:
+                    //
+                    // A later line can come out evaluated above an earlier one, as every line is searched with its own
+                    // window and with a transposition table the earlier lines have since filled. The lines found so far
+                    // are kept sorted by their evaluations (keeping the search order between equal evaluations), so
+                    // the lines are reported best first and the next iteration centers every line's window around the
+                    // evaluation of the line in its place
+                    for (uint8_t line = PVLine; line > 0 && LineEvaluations[line] > LineEvaluations[line - 1]; line--) {
+                        std::swap(LineMoves      [line], LineMoves      [line - 1]);
+                        std::swap(LineEvaluations[line], LineEvaluations[line - 1]);
+                        std::swap(linePVs        [line], linePVs        [line - 1]);
+                    }
+
+                    found++;
+                }
+
+                PVLine = 0;
+
+                if (found) {
+                    Evaluation = LineEvaluations[0];
+                    BestMove   = LineMoves      [0];
+
+                    // Every thread keeps the result of its last completed iteration, so the results of all threads can
+                    // be weighed against each other once the search concludes
+                    Result = {
+                        .Depth      = IDepth,
+                        .Evaluation = Evaluation,
+                        .Move       = BestMove,
+                        .PVEntry    = linePVs[0]
+                    };
+                }
+
+                // On the main thread, we need to fire events to notify handlers about the completion of every line of
+                // the iterative deepening iteration and provide them with the results
+                if (ThreadType == Main)
+                    for (uint8_t line = 0; line < found; line++)
+                        EventHandler::HandleIterativeDeepeningIterationCompletion(
+                            IterationCompletionEvent(IDepth, LineEvaluations[line], linePVs[line], line + 1, lines)
+                        );
 
+                if (Stopped()) break;
+
+                RootMoves.Conclude(BestMove);
+
+                // If we are on the main thread, we should also try to see if our search is stable enough. If it is, we
+                // can avoid spending much more time on the search and instead save time for when we have multiple good
+                // moves to choose from
                 if (ThreadType == Main) {
-                    // On the main thread, we need to fire events to notify handlers about the completion of the
-                    // iterative deepening iteration and provide them with the results. Furthermore, if we are on the
-                    // main thread, we should also try to see if our search is stable enough. If it is, we can avoid
-                    // spending much more time on the search and instead save time for when we have multiple good moves
-                    // to choose from
-
-                    const auto time = ElapsedTime();
-
-                    SearchStabilityTimeOptimization(lastBestMove);
-
-                    EventHandler::HandleIterativeDeepeningIterationCompletion({
-                        .Depth          = IDepth,
-                        .SelectiveDepth = SelectiveDepth,
-                        .Evaluation     = WDLCalculator::S(Board, Evaluation),
-                        .WDL            = WDL(Board, Evaluation),
-                        .Nodes          = Nodes,
-                        .Time           = time,
-                        .PVEntry        = PVTable[0]
-                    });
+                    SearchStabilityTimeOptimization(lastBestMove  );
+                    SearchEffortTimeOptimization   (lastEvaluation);
                 }
 
+                // Once a mate within the requested number of moves is proven, there is nothing left to search for
+                if (MateProven()) break;
+
                 IDepth++;
             }
 
-            Status = SearchThreadStatus::Stopped;
+            // While pondering or searching infinitely, the best move can't be reported before the opponent has played
+            // the expected move or the search was stopped, even if the search concluded on its own (reached its depth
+            // or found a mate)
+            if (ThreadType == Main) while ((Pondering() || Limit.Infinite) && !Stopped()) Sleep(1);
+
+            // Whatever is left in the local batch still counts towards the shared budget
+            FlushNodes();
+
+            Stop();
 
             if (ThreadType == Main) {
                 // The main thread is responsible for notifying the handlers about the completion of the search,
-                // providing them with the best move found
+                // providing them with the best move found, and the move it expects the opponent to reply with. If the
+                // search was timed, it also reports how its time was managed
+
+                if (Limit.Timed) EventHandler::HandleSearchTimeStatistics({
+                    .Depth           = Result.Depth,
+                    .Time            = ElapsedTime(),
+                    .OptimalTime     = Limit.OptimalTime,
+                    .SoftTime        = SoftTime(),
+                    .ActualTime      = Limit.ActualTime,
+                    .Stability       = SearchStability,
+                    .NodeShare       = SearchEffortNodeShare,
+                    .EvaluationDelta = SearchEffortEvaluationDelta,
+                    .Effort          = SearchEffort
+                });
 
                 EventHandler::HandleIterativeDeepeningCompletion({
-                    .Move = BestMove
+                    .Move       = BestMove,
+                    .PonderMove = Result.Move == BestMove ? PonderMove(Result) : Move()
                 });
             }
+
+            State.Finished.store(true, std::memory_order_release);
         }
 
-        void Stop() { Status = SearchThreadStatus::Stopped; }
+        void Stop() { State.Status.store(SearchThreadStatus::Stopped, std::memory_order_relaxed); }
+
+        bool Stopped() const { return State.Status.load(std::memory_order_relaxed) == SearchThreadStatus::Stopped; }
+
+        bool Finished() const { return State.Finished.load(std::memory_order_acquire); }
+
+        void Ponder() { State.Pondering.store(true, std::memory_order_relaxed); }
+
+        void PonderHit()
+        {
+            State.PonderHitTime.store(
+                std::chrono::steady_clock::now().time_since_epoch().count(),
+                std::memory_order_relaxed
+            );
+            State.Pondering.store(false, std::memory_order_release);
+        }
 
-        bool Stopped() const { return Status == SearchThreadStatus::Stopped; }
+        bool Pondering() const { return State.Pondering.load(std::memory_order_acquire); }
+
+        static Move PonderMove(const IterativeDeepeningResult& result)
+        {
+            return result.PVEntry.Ply > 1 ? result.PVEntry.PV[1] : Move();
+        }
 
         Score GetEvaluation() const { return WDLCalculator::S(Board, Evaluation); }
 
+        const IterativeDeepeningResult& GetResult() const { return Result; }
+
+        uint8_t GetMultiPV() const { return Limit.MultiPV; }
+
+        IterativeDeepeningIterationCompletionEvent IterationCompletionEvent() const
+        { return IterationCompletionEvent(Result.Depth, Result.Evaluation, Result.PVEntry, 1, 1); }
+
         WDL GetWDL() const { return WDL(Board, Evaluation); }
 
         MS ElapsedTime() const
         { return std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - StartTime); }
 
         private:
+        IterativeDeepeningIterationCompletionEvent IterationCompletionEvent(const int16_t  depth     ,
+                                                                            const Score    evaluation,
+                                                                            const PVEntry& pv        ,
+                                                                            const uint8_t  line      ,
+                                                                            const uint8_t  lines     ) const
+        {
+            return {
+                .Depth          = depth,
+                .SelectiveDepth = SelectiveDepth,
+                .Evaluation     = WDLCalculator::S(Board, evaluation),
+                .WDL            = WDL(Board, evaluation),
+                .Nodes          = GetNodes(),
+                .Time           = ElapsedTime(),
+                .PVEntry        = pv,
+                .Line           = line,
+                .Lines          = lines
+            };
+        }
+
+        bool SearchableRootMove(const Move move) const
+        {
+            // The interface may restrict the search to a subset of the root moves, and the moves heading the lines
+            // already found in this iteration are excluded when searching for multiple lines
+            if (!Limit.SearchMoves.empty() && std::ranges::find(Limit.SearchMoves, move) == Limit.SearchMoves.end())
+                return false;
+
+            for (uint8_t line = 0; line < PVLine; line++) if (LineMoves[line] == move) return false;
+
+            return true;
+        }
+
+        template<Color Color>
+        void InitializeRootMoves()
+        {
+            OrderedMoveList<Color> moves (Board, 0, Killer, History);
+
+            RootMoves.Clear();
+
+            for (uint8_t i = 0; i < moves.Count(); i++)
+                if (const Move move = moves[i]; SearchableRootMove(move)) RootMoves.Add(move);
+
+            if (ExpectedMove != Move()) RootMoves.Prioritize(ExpectedMove);
+
+            // Until the first iteration completes, the move the policy considers the best is the best move, so that a
+            // search stopped before then (for example, when the clock is almost out) still plays a legal move
+            if (RootMoves.Count()) BestMove = RootMoves.First();
+        }
+
+        // The side to move at the root is mating within the number of moves requested by a mate search
+        bool MateProven() const
+        {
+            return Limit.Mate && IsWin(Evaluation) && PlyToMate(Evaluation) <= MatePly();
+        }
+
+        uint8_t MatePly() const { return 2 * Limit.Mate - 1; }
+
+        // Share of the nodes in the last completed iteration that were spent on the best move
+        double BestMoveNodeShare() const { return RootMoves.NodeShare(BestMove); }
+
         template<Limit::TimeType Type>
         bool OutOfTime() const
         {
             if (!Limit.Timed) return false;
 
-            return Type == Limit::Actual ? ElapsedTime() > Limit. ActualTime
-                                         : ElapsedTime() > Limit.OptimalTime;
+            // Pondering:
+            //
+            // While pondering, we are searching on the opponent's time, so we can't run out of time. Once the opponent
+            // plays the expected move (ponder hit), the search continues as a regular timed search, with the time
+            // limits counting from the ponder hit rather than from the start of the search
+            if (Pondering()) return false;
+
+            const TP ponderHit { TP::duration(State.PonderHitTime.load(std::memory_order_relaxed)) };
+
+            const auto elapsed = std::chrono::duration_cast<MS>(
+                std::chrono::steady_clock::now() - std::max(StartTime, ponderHit)
+            );
+
+            return Type == Limit::Actual ? elapsed > Limit.ActualTime
+                                         : elapsed > SoftTime();
+        }
+
+        MS SoftTime() const
+        {
+            return std::min(MS(Limit.OptimalTime.count() * SearchEffort / 100), Limit.ActualTime);
+        }
+
+        int16_t StartDepth() const
+        {
+            // Staggered Start Depth:
+            //
+            // Helper threads start their iterative deepening at slightly different depths, so they are spread over
+            // different iterations from the very beginning instead of racing the main thread through the same shallow
+            // iterations. The shallow iterations are cheap, so the transposition table quickly fills up with enough
+            // entries to guide the deeper iterations regardless
+            if (ThreadType == Main || !HelperDiversification.StartDepth) return 1;
+
+            return 1 + ThreadId % HelperStartDepthCycle;
+        }
+
+        bool SkipDepth() const
+        {
+            // Depth Skipping:
+            //
+            // Relevant links:
+            // - https://www.chessprogramming.org/Lazy_SMP
+            //
+            // Each helper thread skips some iterations following a pattern determined by its thread ID, with a skip
+            // size (how many consecutive iterations are searched or skipped) and a phase (where in the pattern the
+            // helper thread starts). This keeps roughly half of the helper threads ahead of the main thread at any
+            // time, filling the transposition table with deeper entries that the main thread can use when it gets
+            // there
+            if (ThreadType == Main || !HelperDiversification.SkipDepth) return false;
+
+            const size_t index = (ThreadId - 1) % HelperSkipSize.size();
+
+            return (IDepth + HelperSkipPhase[index]) / HelperSkipSize[index] % 2;
         }
 
         void SearchSingleMoveTimeOptimization()
@@ -467,6 +1021,50 @@ namespace StockDory
             Limit.OptimalTime = MS(std::min<uint64_t>(time * factor / 100, Limit.ActualTime.count()));
         }
 
+        void SearchEffortTimeOptimization(const Score lastEvaluation)
+        {
+            if (!Limit.Timed) return;
+            if ( Limit.Fixed) return;
+
+            if (IDepth < SearchEffortMinimumDepth || lastEvaluation == -Infinity) return;
+
+            // Best Move Effort:
+            //
+            // If most of the last iteration's nodes were spent on the best move, the other moves were refuted quickly
+            // and the best move is clear, so we can stop earlier. If the nodes were spread over several moves, some of
+            // the other moves came close to being the best move, and we should spend more time to be sure. The time is
+            // scaled by: (base - node share) * multiplier
+            SearchEffortNodeShare = BestMoveNodeShare();
+
+            const auto nodeFactor = static_cast<uint16_t>(
+                (NodeShareTimeBase - SearchEffortNodeShare * 100) * NodeShareTimeMultiplier / 100
+            );
+
+            // Evaluation Volatility:
+            //
+            // If the evaluation dropped since the last iteration, the position is likely more critical than it seemed
+            // and we should spend more time on it, while if the evaluation rose, we can spend a little less. Every
+            // centipawn of change scales the time by a percent, within bounds. Mate scores aren't on the same scale as
+            // evaluations, so a change to or from one says nothing about volatility and leaves the time unscaled
+            const bool mate = IsMate(Evaluation) || IsMate(lastEvaluation);
+
+            SearchEffortEvaluationDelta = mate ? 0 : Evaluation - lastEvaluation;
+
+            const auto volatilityFactor = static_cast<uint16_t>(std::clamp<Score>(
+                100 - SearchEffortEvaluationDelta,
+                ScoreVolatilityTimeMinimum,
+                ScoreVolatilityTimeMaximum
+            ));
+
+            // Unlike the search stability optimization, this scale is recomputed from scratch every iteration rather
+            // than compounding on top of the previous iterations' scales
+            SearchEffort = std::clamp<uint16_t>(
+                static_cast<uint16_t>(nodeFactor * volatilityFactor / 100),
+                SearchEffortTimeMinimum,
+                SearchEffortTimeMaximum
+            );
+        }
+
         template<Color Color>
         Score Aspiration(const int16_t depth)
         {
@@ -477,10 +1075,32 @@ namespace StockDory
             //
             // If we have done enough full window search iterations at lower depths to get a relatively accurate
             // evaluation, then all future search iterations can be done with a smaller window centered around the
-            // evaluation from the previous search iteration: (evaluation - margin, evaluation + margin)
-            if (depth >= AspirationWindowMinimumDepth) {
-                alpha = Evaluation - AspirationWindowMargin;
-                beta  = Evaluation + AspirationWindowMargin;
+            // evaluation from the previous search iteration: (evaluation - margin, evaluation + margin). Helper
+            // threads that started deeper or skipped iterations may not have such an evaluation yet. With multiple
+            // lines, every line's window is centered around that line's evaluation from the previous search iteration
+            const Score evaluation = LineEvaluations[PVLine];
+            if (depth >= AspirationWindowMinimumDepth && evaluation != -Infinity) {
+                // Window Perturbation:
+                //
+                // Helper threads search with slightly different windows than the main thread, causing them to fail
+                // high or low (and research) at different points and consequently explore different parts of the tree
+                Score margin = AspirationWindowMargin;
+                if (ThreadType == Parallel)
+                    margin += HelperDiversification.WindowPerturbation * (ThreadId % HelperWindowPerturbationCycle);
+
+                alpha = evaluation - margin;
+                beta  = evaluation + margin;
+            }
+
+            // Mate Window:
+            //
+            // When searching for a mate within a number of moves, only evaluations proving such a mate matter, so the
+            // window's lower bound is set just below the evaluation of the slowest mate requested. Everything else
+            // fails low and is cut off as early as possible, and the mate distance pruning keeps the mating lines from
+            // wandering past the requested distance
+            if (Limit.Mate) {
+                alpha = WinIn(MatePly()) - 1;
+                beta  = Infinity;
             }
 
             uint8_t research = 0;
@@ -488,12 +1108,11 @@ namespace StockDory
                 if (ThreadType == Main) {
                     // If we are in the main thread, we should regularly (every search/research) check if the search's
                     // limits have been crossed. If they have, we should stop searching/researching
-                    if (OutOfTime<Limit::Actual>()) [[unlikely]]
-                        Status = SearchThreadStatus::Stopped;
+                    if (OutOfTime<Limit::Actual>()) [[unlikely]] Stop();
                 }
 
                 // If the search was stopped, we should return a draw score immediately
-                if (Status == SearchThreadStatus::Stopped) [[unlikely]] return Draw;
+                if (Stopped()) [[unlikely]] return Draw;
 
                 // Window Fallback:
                 //
@@ -505,6 +1124,9 @@ namespace StockDory
 
                 const Score bestEvaluation = PVS<Color, true, true>(0, depth, alpha, beta);
 
+                // A mate search failing low hasn't found a mate at this depth, there is no point in widening the window
+                if (Limit.Mate && bestEvaluation <= alpha) return bestEvaluation;
+
                 // Possible Search Window Extending:
                 //
                 // The search window is centered around the evaluation, but it may not always capture initially capture
@@ -529,9 +1151,10 @@ namespace StockDory
 
                     beta  = std::min<Score>(beta  + research * research * AspirationWindowMarginDelta,  Infinity);
 
-                    BestMove = PVTable[0].PV[0];
+                    // Only the first line is headed by the best move
+                    if (PVLine == 0) BestMove = PVTable[0].PV[0];
                 } else {
-                    BestMove = PVTable[0].PV[0];
+                    if (PVLine == 0) BestMove = PVTable[0].PV[0];
                     return bestEvaluation;
                 }
             }
@@ -546,33 +1169,36 @@ namespace StockDory
             if (ThreadType == Main) {
                 // If we are in the main thread, we should regularly (every 4096 nodes) check if the search's limits
                 // have been crossed. If they have, we should stop searching
-                if ((Nodes & 4095) == 0 && OutOfTime<Limit::Actual>()) [[unlikely]]
-                    Status = SearchThreadStatus::Stopped;
-
-                // If we have exceeded the maximum node limit, we should stop searching
-                if (Nodes > Limit.Nodes) [[unlikely]]
-                    Status = SearchThreadStatus::Stopped;
+                if ((GetNodes() & 4095) == 0 && OutOfTime<Limit::Actual>()) [[unlikely]] Stop();
             }
 
             // If the search was stopped, we should return a draw score immediately
-            if (Status == SearchThreadStatus::Stopped) [[unlikely]] return Draw;
-
-            if (ThreadType == Main) {
-                // The main thread is responsible for ensuring the PV Table is correctly updated with the right moves
-                // and that the correct selective depth is reported
+            if (Stopped()) [[unlikely]] return Draw;
 
-                PVTable[ply].Ply = ply;
+            // The search stack and PV Table only have room for so many plies, which very deep (infinite) searches can
+            // reach. There, the static evaluation has to do
+            if (ply >= MaxDepth - 1) [[unlikely]] return EvaluateScaled<Color>();
 
-                if (PV) SelectiveDepth = std::max(SelectiveDepth, ply);
-            }
+            // Every thread keeps its PV Table updated with the right moves and keeps track of its selective depth, as
+            // the results of any thread may end up being reported
+            PVTable[ply].Ply = ply;
 
-            const bool checked = Board.Checked<Color>();
+            if (PV) SelectiveDepth = std::max(SelectiveDepth, ply);
 
             // If we've exhausted our search depth and aren't in check, we should check if there are any tactical
             // sequences just over the horizon. If there are, we should get a more accurate evaluation through a
             // Quiescence search. If we are in check, we should go down the normal search path, extending as needed to
-            // ensure we find a suitable evasion
-            if (depth <= 0 && !checked) return Quiescence<Color, PV>(ply, alpha, beta);
+            // ensure we find a suitable evasion. Only whether we are in check matters here, which is cheaper to find
+            // out than the checks themselves
+            if (depth <= 0 && !Board.Checked<Color>()) return Quiescence<Color, PV>(ply, alpha, beta);
+
+            // The checks against us are needed for move generation as well, so now that the node is searched, they are
+            // worked out in full and shared with the rest of the node. The attack record built from them is only built
+            // once the node generates moves, by ProbCut or the move loop, whichever comes first
+            const CheckBitBoard check   = Board.Check<OColor>();
+            const bool          checked = check.Check != BBFilled;
+
+            std::optional<AttackRecord> attackRecord;
 
             const ZobristHash hash = Board.Zobrist();
 
@@ -605,14 +1231,11 @@ namespace StockDory
                 // - If there are only kings and a knight left (belonging to either side)
                 // - If there are only kings and a bishop left (belonging to either side)
                 {
-                    const uint8_t pieceCount = Count(~Board[NAC]);
+                    const uint8_t pieceCount = Board.PieceCount();
 
                     if (pieceCount == 2) return Draw;
 
-                    const bool knightLeft = Board.PieceBoard<White>(Knight) | Board.PieceBoard<Black>(Knight),
-                               bishopLeft = Board.PieceBoard<White>(Bishop) | Board.PieceBoard<Black>(Bishop);
-
-                    if (pieceCount == 3 && (knightLeft || bishopLeft)) return Draw;
+                    if (pieceCount == 3 && (Board.PieceCount(Knight) || Board.PieceCount(Bishop))) return Draw;
                 }
 
                 // Mate Distance Pruning:
@@ -632,18 +1255,32 @@ namespace StockDory
             // exists a transposition entry - if the entry is valid, depending on the quality of the entry, we can
             // return the evaluation from the entry. Even if the entry isn't of sufficient quality to return directly,
             // we can still search the move in the entry first, since it most likely is the best move in the position
-            SearchTranspositionEntry& ttEntry      = TT[hash];
-            Move                      ttMove       = {};
-            bool                      ttHit        = false;
-            Score                     ttEvaluation = None;
+            //
+            // The entry lives in the shared table and can be overwritten by another thread (or deeper in this search)
+            // at any time, so everything used from it is copied at the probe, keeping its fields consistent
+            SearchTranspositionEntry&    ttEntry      = TT[hash];
+            Move                         ttMove       = {};
+            bool                         ttHit        = false;
+            Score                        ttEvaluation = None;
+            uint8_t                      ttDepth      = 0;
+            SearchTranspositionEntryType ttType       = Invalid;
+
+            // Excluded Move:
+            //
+            // A search of this position that leaves out one of its moves doesn't search the same tree as the one the
+            // transposition table entry came from, so the entry can't be returned directly and the search's result
+            // must not be stored
+            const Move excluded = Stack[ply].ExcludedMove;
 
             if (ttEntry.Type != Invalid && ttEntry.Hash == CompressHash(hash)) {
-                ttHit  = true;
-                ttMove = ttEntry.Move;
+                ttHit   = true;
+                ttMove  = ttEntry.Move;
+                ttDepth = ttEntry.Depth;
+                ttType  = ttEntry.Type;
 
                 ttEvaluation = DecompressScore(ttEntry.Evaluation, ply);
 
-                if (!PV && ttEntry.Depth >= depth) {
+                if (!PV && !excluded && ttDepth >= depth) {
                     // If the entry is of sufficient quality, depending on the bounding type of the entry, we can
                     // directly return the evaluation from the entry. We shouldn't do this in PV branches as even a
                     // slight inaccuracy due to hash collisions or other factors can cause us to miss a good move.
@@ -658,9 +1295,9 @@ namespace StockDory
                     // - Alpha: The evaluation never exceeded alpha in the producing search, but we should only return
                     //          if we know it isn't exceeding alpha in the current search
 
-                    if (ttEntry.Type == Exact                         ) return ttEvaluation;
-                    if (ttEntry.Type == Beta  && ttEvaluation >= beta ) return ttEvaluation;
-                    if (ttEntry.Type == Alpha && ttEvaluation <= alpha) return ttEvaluation;
+                    if (ttType == Exact                         ) return ttEvaluation;
+                    if (ttType == Beta  && ttEvaluation >= beta ) return ttEvaluation;
+                    if (ttType == Alpha && ttEvaluation <= alpha) return ttEvaluation;
                 }
             }
 
@@ -674,6 +1311,9 @@ namespace StockDory
             Score staticEvaluation;
             bool  improving       ;
 
+            // The neural network evaluation adjusted by the correction history, if it was evaluated
+            Score correctedEvaluation = None;
+
             if (checked) {
                 // Last non-checked Static Evaluation:
                 //
@@ -724,13 +1364,13 @@ namespace StockDory
             if (ttHit) {
                 staticEvaluation = ttEvaluation;
 
-                if (ttEntry.Type != Exact) {
-                    const Score nnEvaluation = EvaluateScaled<Color>();
+                if (ttType != Exact) {
+                    const Score nnEvaluation = correctedEvaluation = EvaluateCorrected<Color>();
 
-                    if      (ttEntry.Type == Beta ) staticEvaluation = std::max<Score>(staticEvaluation, nnEvaluation);
-                    else if (ttEntry.Type == Alpha) staticEvaluation = std::min<Score>(staticEvaluation, nnEvaluation);
+                    if      (ttType == Beta ) staticEvaluation = std::max<Score>(staticEvaluation, nnEvaluation);
+                    else if (ttType == Alpha) staticEvaluation = std::min<Score>(staticEvaluation, nnEvaluation);
                 }
-            } else staticEvaluation = EvaluateScaled<Color>();
+            } else staticEvaluation = correctedEvaluation = EvaluateCorrected<Color>();
 
             Stack[ply].StaticEvaluation = staticEvaluation;
 
@@ -794,7 +1434,7 @@ namespace StockDory
                 // binary search window, centered around our upper bound (beta) as their lower bound (alpha). If the
                 // branch is bad for the opponent, they'll be unable to improve upon their lower bound and fail-low. In
                 // turn, this can allow us to produce a beta cut-off and prune this branch
-                if (!Root && depth >= NullMoveMinimumDepth && staticEvaluation >= beta) {
+                if (!Root && !excluded && depth >= NullMoveMinimumDepth && staticEvaluation >= beta) {
                     // The reduced depth is determined by the below formula:
                     //
                     // d = current depth
@@ -822,6 +1462,8 @@ namespace StockDory
                           +  ScalingEvaluationReduction
                           );
 
+                    Stack[ply].MovedPiece = NAP;
+
                     const PreviousStateNull state = Board.Move();
 
                     const auto evaluation = -PVS<OColor, false, false>(
@@ -835,6 +1477,64 @@ namespace StockDory
 
                     if (evaluation >= beta) return beta;
                 }
+
+                // ProbCut:
+                //
+                // Relevant links:
+                // - https://www.chessprogramming.org/ProbCut
+                //
+                // ProbCut is a pruning technique that allows us to prune branches where a good capture is very likely
+                // to produce a beta cut-off even at full depth. If a capture beats a raised upper bound
+                // (beta + margin) in a much shallower search, it is very likely to beat the actual upper bound (beta)
+                // in a full depth search as well. To keep this cheap, every capture that can possibly beat the raised
+                // upper bound (according to SEE) is first verified by a Quiescence search, and only the captures that
+                // pass are searched at a reduced depth. Proven beta cut-offs are stored in the transposition table, so
+                // they can be reused without going through ProbCut again
+                const Score probCutBeta = beta + ProbCutMargin;
+                if (!Root && !excluded && depth >= ProbCutMinimumDepth && abs(beta) < MateInMaxDepth &&
+                    !(ttHit && ttDepth >= depth - ProbCutDepthReduction && ttEvaluation < probCutBeta)) {
+                    attackRecord.emplace(Board.Attacks<Color>(check));
+
+                    OrderedMoveList<Color, true> captures (
+                        Board, ply, Killer, History, ttMove, nullptr, nullptr, &CaptureHistory, &*attackRecord
+                    );
+
+                    const int16_t probCutDepth = depth - ProbCutDepthReduction;
+
+                    for (uint8_t i = 0; i < captures.Count(); i++) {
+                        const InternalMove move = captures[i];
+
+                        if (!SEE::Accurate(Board, move, probCutBeta - staticEvaluation)) continue;
+
+                        const PreviousState state = DoMove<true>(move, ply);
+
+                        Score evaluation = -Quiescence<OColor, false>(ply + 1, -probCutBeta, -probCutBeta + 1);
+
+                        if (evaluation >= probCutBeta)
+                            evaluation = -PVS<OColor, false, false>(
+                                ply + 1,
+                                probCutDepth - 1,
+                                -probCutBeta,
+                                -probCutBeta + 1
+                            );
+
+                        UndoMove<true>(state, move, ply);
+
+                        if (Stopped()) [[unlikely]] return Draw;
+
+                        if (evaluation >= probCutBeta) {
+                            TryReplaceTT(ttEntry, {
+                                .Hash       = CompressHash(hash),
+                                .Evaluation = CompressScore(evaluation, ply),
+                                .Move       = move,
+                                .Depth      = static_cast<uint8_t>(probCutDepth),
+                                .Type       = Beta
+                            });
+
+                            return evaluation;
+                        }
+                    }
+                }
             }
 
             // We continue from here if we are in check
@@ -842,7 +1542,72 @@ namespace StockDory
 
             using MoveList = OrderedMoveList<Color>;
 
-            MoveList moves (Board, ply, Killer, History, ttMove);
+            // Continuation History:
+            //
+            // Relevant links:
+            // - https://www.chessprogramming.org/History_Heuristic
+            // - https://www.chessprogramming.org/Countermove_Heuristic
+            //
+            // The history table tells us how good a quiet move is regardless of how we got here, but many quiet moves
+            // are only good as a reply to a specific move. The counter-move history (indexed by the opponent's last
+            // move) and follow-up history (indexed by our own last move) tell us how good a quiet move is as a
+            // continuation of those moves, and are used alongside the history table
+            const CHEntry* counterMove = ContinuationHistory ? ContinuationEntry<Color>(*CounterMoveHistory, ply, 1)
+                                                             : nullptr;
+            const CHEntry*    followUp = ContinuationHistory ? ContinuationEntry<Color>(   *FollowUpHistory, ply, 2)
+                                                             : nullptr;
+
+            // Attack Record:
+            //
+            // The pins and checks needed to generate the moves, along with what's needed to tell whether a move gives
+            // check without making it, are worked out once for the position and shared by ProbCut, move generation,
+            // ordering and pruning. ProbCut may have already built it
+            if (!attackRecord) attackRecord.emplace(Board.Attacks<Color>(check));
+
+            const AttackRecord& attacks = *attackRecord;
+
+            MoveList moves (Board, ply, Killer, History, ttMove, counterMove, followUp, &CaptureHistory, &attacks);
+
+            // Root Move Restrictions:
+            //
+            // The interface may restrict the search to a subset of the root moves, and with multiple lines, the root
+            // moves heading the lines found earlier in the iteration are excluded
+            if (Root && (!Limit.SearchMoves.empty() || PVLine))
+                moves.Retain([this](const Move move) -> bool { return SearchableRootMove(move); });
+
+            // Root Move Ordering:
+            //
+            // The root moves are ordered by the root move table, which keeps the best move of the previous iteration
+            // first, followed by the other moves in order of how many nodes were spent on them in the previous
+            // iteration. The transposition table move still comes first, since during an iteration it holds the move
+            // that failed high most recently
+            if (Root)
+                moves.Rescore([this](const Move move, const uint32_t score) -> uint32_t
+                    {
+                        return score == std::numeric_limits<uint32_t>::max() ? score
+                                                                             : RootMoves.Priority(move, score);
+                    }
+                );
+
+            // Check-First Ordering:
+            //
+            // When searching for a mate, the side looking to mate most often gets there by checking the opponent
+            // (which also leaves the opponent with the fewest replies), so its checking moves are searched first,
+            // only behind the transposition table move. At the root, this goes on top of the root move ordering, so
+            // the checks keep the order the root move table gives them, followed by the other moves
+            static_assert(RootMoveTable::PriorityBase + MateCheckBonus < std::numeric_limits<uint32_t>::max());
+
+            if (Limit.Mate && ply % 2 == 0)
+                moves.Rescore([this, &attacks](const Move move, const uint32_t score) -> uint32_t
+                    {
+                        if (score == std::numeric_limits<uint32_t>::max()) return score;
+
+                        const bool givesCheck =
+                            Board.GivesCheck<Color>(attacks, move.From(), move.To(), move.Promotion());
+
+                        return givesCheck ? score + MateCheckBonus : score;
+                    }
+                );
 
             // Out of Moves:
             //
@@ -863,12 +1628,45 @@ namespace StockDory
 
             Score bestEvaluation = -Infinity;
 
+            // Moves deferred because another thread is searching them (ABDADA), searched after all the other moves
+            Array<uint8_t, MaxMove> deferred;
+            uint8_t                 deferredCount = 0;
+
+            const bool deferring = SearchingMoves.Enabled() && depth >= ABDADAMinimumDepth;
+
+            // Quiet moves searched so far, to reduce their history if another quiet move causes a beta cut-off
+            Array<InternalMove, MaxMove> searchedQuiets;
+            uint8_t                      searchedQuietCount = 0;
+
+            // Captures searched so far, to reduce their capture history if another move causes a beta cut-off
+            Array<InternalMove, MaxMove> searchedCaptures;
+            uint8_t                      searchedCaptureCount = 0;
+
             uint8_t quietMoves = 0;
-            for (uint8_t i = 0; i < moves.Count(); i++) {
-                const Move move = moves[i];
+            for (uint16_t n = 0; n < moves.Count() + deferredCount; n++) {
+                const bool         revisit = n >= moves.Count();
+                const uint8_t      i       = revisit ? deferred[n - moves.Count()] : n;
+                const InternalMove move    = revisit ? moves.UnsortedAccess(i) : moves[i];
+
+                if (move == excluded) continue;
+
+                // Move Deferral (ABDADA):
+                //
+                // Relevant links:
+                // - https://www.chessprogramming.org/ABDADA
+                //
+                // If another thread is already searching this move in this position, searching it simultaneously
+                // just duplicates its work. Instead, we defer the move and search the other moves first - by the time
+                // we get back to it, the other thread has most likely finished, and the result will be waiting in the
+                // transposition table. The first move is never deferred, as it's the one most likely to produce a
+                // beta cut-off, making the other moves irrelevant
+                if (deferring && !revisit && i > 0 && SearchingMoves.Searching(hash, move)) {
+                    deferred[deferredCount++] = i;
+                    continue;
+                }
 
-                const Piece movingPiece = Board[move.From()].Piece();
-                const Piece targetPiece = Board[move.  To()].Piece();
+                const Piece movingPiece = move.Piece();
+                const Piece targetPiece = move.Captured();
 
                 const bool quiet = targetPiece == NAP;
 
@@ -884,11 +1682,18 @@ namespace StockDory
                 // the static evaluation of the current position is significantly worse than our lower bound (alpha),
                 // it is very unlikely that a non-tactical move will improve our position enough to exceed our lower
                 // bound (alpha). Searching further in this branch is not going to change the outcome of this branch,
-                // so we can stop early
-                if (i > 0 && quiet) {
+                // so we can stop early. If our lower bound is already a win (as in a mate search), only a mate can
+                // exceed it, which the static evaluation can't tell us anything about
+                if (i > 0 && quiet && !IsWin(alpha)) {
                     const Score margin = depth * FutilityDepthFactor;
 
-                    if (staticEvaluation + margin <= alpha) break;
+                    if (staticEvaluation + margin <= alpha) {
+                        // Deferred moves were ordered before this move, so they should still be searched
+                        if (revisit || !deferredCount) break;
+
+                        n = moves.Count() - 1;
+                        continue;
+                    }
                 }
 
                 if (!PV) {
@@ -908,10 +1713,65 @@ namespace StockDory
                     // and will be searched earlier. If we are at a point where we've even searched a few quiet moves,
                     // then it is very likely we've already searched the good moves and searching further is not going
                     // to change the outcome of this branch - so we can stop early
-                    if (doLMP && quietMoves > lmpLastQuiet && bestEvaluation > -Infinity) break;
+                    if (doLMP && quietMoves > lmpLastQuiet && bestEvaluation > -Infinity) {
+                        // Deferred moves were ordered before this move, so they should still be searched
+                        if (revisit || !deferredCount) break;
+
+                        n = moves.Count() - 1;
+                        continue;
+                    }
                 }
 
-                const PreviousState state = DoMove<true>(move, ply, quiet);
+                // Singular Search:
+                //
+                // Relevant links:
+                // - https://www.chessprogramming.org/Singular_Extensions
+                // - https://www.chessprogramming.org/Multi-Cut
+                //
+                // We can find out whether the position hinges on the transposition table move by searching the position
+                // without it at half the depth, against a bound a margin below the transposition table evaluation. If
+                // none of the other moves reach the bound, the transposition table move is singular. Singular moves
+                // are commonly extended, but with the current network the extensions cost far more time than they
+                // gain, so the move is searched at its regular depth. If another move does reach the bound:
+                //
+                // - Multi-Cut: if the bound is at least our upper bound (beta), there are multiple moves causing a beta
+                //   cut-off - the transposition table move and the other move - so this node is very likely to cause a
+                //   beta cut-off, and we can prune it right away
+                // - Negative Extension: if the transposition table evaluation is at least our upper bound (beta), the
+                //   transposition table move isn't the only move likely to cause a beta cut-off, so the node doesn't
+                //   hinge on it, and it is searched at a reduced depth
+                int16_t extension = 0;
+                if (!Root && !excluded && move == ttMove && depth >= SingularMinimumDepth &&
+                    ttType != Alpha && ttDepth >= depth - SingularTTDepthMargin &&
+                    abs(ttEvaluation) < MateInMaxDepth) {
+                    const Score singularBeta = ttEvaluation - depth * SingularBetaDepthFactor;
+
+                    Stack[ply].ExcludedMove = move;
+
+                    const Score evaluation = PVS<Color, false, false>(
+                        ply,
+                        (depth - 1) / 2,
+                        singularBeta - 1,
+                        singularBeta
+                    );
+
+                    Stack[ply].ExcludedMove = {};
+
+                    if (Stopped()) [[unlikely]] return Draw;
+
+                    if (evaluation >= singularBeta) {
+                        if (singularBeta >= beta) return singularBeta;
+                        if (ttEvaluation >= beta) extension = -SingularNegativeExtension;
+                    }
+                }
+
+                if (deferring) SearchingMoves.Mark(hash, move);
+
+                const uint64_t nodes = Root ? GetNodes() : 0;
+
+                const bool givesCheck = Board.GivesCheck<Color>(attacks, move.From(), move.To(), move.Promotion());
+
+                const PreviousState state = DoMove<true>(move, ply);
 
                 // Principle Variation Search (PVS):
                 //
@@ -926,7 +1786,10 @@ namespace StockDory
 
                 Score evaluation = 0;
 
-                if (i == 0) evaluation = -PVS<OColor, PV, false>(ply + 1, depth - 1, -beta, -alpha);
+                // The depth moves are searched to, unless they are reduced
+                const int16_t newDepth = depth - 1 + extension;
+
+                if (i == 0) evaluation = -PVS<OColor, PV, false>(ply + 1, newDepth, -beta, -alpha);
                 else {
                     // Assume we are not in a PV branch and use a reduced window search. If the reduced window search
                     // shows potential to improve our position, we will research with a full window search assuming
@@ -947,7 +1810,7 @@ namespace StockDory
                         // move number. Current formula:
                         //
                         // r = floor((ln(depth) * ln(i) / 2 - 0.2) * LMRGranularityFactor)
-                        int32_t r = LMRTable[depth][i];
+                        int32_t r = LMRTable[std::min<int16_t>(depth, MaxDepth - 1)][i];
 
                         // If we are not in a PV branch, we can afford to reduce the search depth further
                         if (!PV) r += LMRNotPVBonus;
@@ -961,11 +1824,11 @@ namespace StockDory
 
                         // If our last move gave check to the opponent, we should try to reduce the search depth less as
                         // the move may be tactical and in certain cases, extend the search depth instead
-                        if (Board.Checked<OColor>()) r -= LMRGaveCheckPenalty;
+                        if (givesCheck) r -= LMRGaveCheckPenalty;
 
                         // Increase reduction for bad history moves and reduce for good history moves (possibly
-                        // extending the search depth)
-                        const int16_t history = History[Color][movingPiece][move.To()];
+                        // extending the search depth), taking the continuation history into account as well
+                        const int32_t history = QuietHistory<Color>(movingPiece, move.To(), counterMove, followUp);
                         r -= history / ((HistoryLimit / LMRHistoryPartition) / LMRHistoryWeight);
 
                         // Divide by the granularity factor to ensure that the fixed-point reduction is correctly
@@ -981,14 +1844,21 @@ namespace StockDory
                     } else evaluation = alpha + 1;
 
                     if (evaluation > alpha) {
-                        evaluation = -PVS<OColor, false, false>(ply + 1, depth - 1, -alpha - 1, -alpha);
+                        evaluation = -PVS<OColor, false, false>(ply + 1, newDepth, -alpha - 1, -alpha);
 
                         if (evaluation > alpha && evaluation < beta)
-                            evaluation = -PVS<OColor, true, false>(ply + 1, depth - 1, -beta, -alpha);
+                            evaluation = -PVS<OColor, true, false>(ply + 1, newDepth, -beta, -alpha);
                     }
                 }
 
-                UndoMove<true>(state, move);
+                UndoMove<true>(state, move, ply);
+
+                if (deferring) SearchingMoves.Unmark(hash, move);
+
+                if (Root && !Stopped()) RootMoves.Update(move, GetNodes() - nodes, evaluation);
+
+                if (quiet) searchedQuiets  [searchedQuietCount  ++] = move;
+                else       searchedCaptures[searchedCaptureCount++] = move;
 
                 if (evaluation <= bestEvaluation) continue;
 
@@ -1001,9 +1871,9 @@ namespace StockDory
                 ttEntryNew.Type = Exact;
                 ttEntryNew.Move =  move;
 
-                if (ThreadType == Main && PV && Status != SearchThreadStatus::Stopped) {
-                    // The main thread is responsible for updating the PV Table in PV branches. We should be careful
-                    // not to do this if the search was stopped, otherwise we may corrupt the PV Table
+                if (PV && !Stopped()) {
+                    // Update the PV Table in PV branches. We should be careful not to do this if the search was
+                    // stopped, otherwise we may corrupt the PV Table
 
                     PVTable[ply].PV[ply] = move;
 
@@ -1015,7 +1885,7 @@ namespace StockDory
 
                 if (evaluation < beta) continue;
 
-                if (Status != SearchThreadStatus::Stopped && quiet) {
+                if (!Stopped() && quiet) {
                     // Killer and History Table Updates:
                     //
                     // Update the Killer and History Table if a quiet move caused a beta cut-off to ensure we search
@@ -1031,12 +1901,25 @@ namespace StockDory
                     }
 
                     // Increase the history value for the current move in the history table
-                    UpdateHistory<Color, true>(move, depth);
+                    UpdateHistory<Color, true>(move, depth, ply);
 
                     // Reduce the history value for all other quiet moves that were searched, since they didn't
                     // cause a beta cut-off
-                    for (uint8_t q = 1; q < quietMoves; q++)
-                        UpdateHistory<Color, false>(moves.UnsortedAccess(i - q), depth);
+                    for (uint8_t q = 0; q < searchedQuietCount - 1; q++)
+                        UpdateHistory<Color, false>(searchedQuiets[q], depth, ply);
+                }
+
+                if (!Stopped()) {
+                    // Capture History Table Updates:
+                    //
+                    // Captures are ordered by what they capture and with what, but how often a capture actually
+                    // causes a beta cut-off tells us much more about it. If the capture caused the beta cut-off, its
+                    // capture history is increased, and every other capture searched before it has its capture history
+                    // reduced, since they didn't cause a beta cut-off (even if a quiet move did)
+                    if (!quiet) UpdateCaptureHistory<Color, true>(move, depth);
+
+                    for (uint8_t c = 0; c < searchedCaptureCount - !quiet; c++)
+                        UpdateCaptureHistory<Color, false>(searchedCaptures[c], depth);
                 }
 
                 ttEntryNew.Type = Beta;
@@ -1045,11 +1928,24 @@ namespace StockDory
 
             ttEntryNew.Evaluation = CompressScore(bestEvaluation, ply);
 
+            // Correction History Update:
+            //
+            // The difference between the search result and the static evaluation tells us how far off the static
+            // evaluation was. Unless the bound of the result doesn't tell us anything about the difference (a lower
+            // bound below or an upper bound above the static evaluation), or the best move is a capture (which the
+            // static evaluation can't be expected to anticipate), the difference is learned for the pawn structure
+            if (!Stopped() && !excluded && correctedEvaluation != None && !IsMate(bestEvaluation) &&
+                (!ttEntryNew.Move || Board[ttEntryNew.Move.To()].Piece() == NAP) &&
+                !(ttEntryNew.Type == Beta  && bestEvaluation <= correctedEvaluation) &&
+                !(ttEntryNew.Type == Alpha && bestEvaluation >= correctedEvaluation))
+                UpdateCorrection<Color>(bestEvaluation - correctedEvaluation, depth);
+
             // Transposition Table Writing:
             //
             // As long as the search has not stopped, we should try to insert/replace the transposition table entry
-            // with the new entry as it is most likely more relevant than the old entry
-            if (Status != SearchThreadStatus::Stopped) TryReplaceTT(ttEntry, ttEntryNew);
+            // with the new entry as it is most likely more relevant than the old entry. The root entry is only written
+            // for the first line, as the later lines don't search the best root move
+            if (!Stopped() && !excluded && !(Root && PVLine)) TryReplaceTT(ttEntry, ttEntryNew);
 
             return bestEvaluation;
         }
@@ -1060,8 +1956,11 @@ namespace StockDory
             // Opponent's color for recursive calls
             constexpr auto OColor = Opposite(Color);
 
-            // The main thread is responsible for ensuring that the correct selective depth is reported
-            if (ThreadType == Main && PV) SelectiveDepth = std::max(SelectiveDepth, ply);
+            // Keep track of the selective depth, so the correct selective depth is reported
+            if (PV) SelectiveDepth = std::max(SelectiveDepth, ply);
+
+            // The search stack only has room for so many plies, there the static evaluation has to do
+            if (ply >= MaxDepth - 1) [[unlikely]] return EvaluateScaled<Color>();
 
             if (!PV) {
                 // Transposition Table Reading:
@@ -1102,24 +2001,28 @@ namespace StockDory
 
             using MoveList = OrderedMoveList<Color, true>;
 
-            MoveList moves (Board, ply, Killer, History);
+            MoveList moves (Board, ply, Killer, History, {}, nullptr, nullptr, &CaptureHistory);
 
             Score bestEvaluation = staticEvaluation;
             for (uint8_t i = 0; i < moves.Count(); i++) {
-                const Move move = moves[i];
+                const InternalMove move = moves[i];
 
                 // Static Exchange Evaluation (SEE) Pruning:
                 //
                 // SEE is essentially an evaluation that determines if an exchange of pieces is materially favorable for
                 // us or not, and if it is not, then that tactical sequence is not worth searching further, and we can
-                // prune that branch entirely
-                if (!SEE::Accurate(Board, move, 0)) continue;
+                // prune that branch entirely. Captures with a bad capture history have rarely worked out in the main
+                // search, so they must win some material on top to be worth searching
+                const int16_t captureHistory = CaptureHistoryOf<Color>(move);
+                const int32_t threshold      = std::max(0, -captureHistory / CaptureHistoryQuiescencePartition);
+
+                if (!SEE::Accurate(Board, move, threshold)) continue;
 
                 const PreviousState state = DoMove<false>(move, ply);
 
                 const Score evaluation = -Quiescence<OColor, PV>(ply + 1, -beta, -alpha);
 
-                UndoMove<false>(state, move);
+                UndoMove<false>(state, move, ply);
 
                 if (evaluation <= bestEvaluation) continue;
 
@@ -1136,17 +2039,22 @@ namespace StockDory
         }
 
         template<bool UpdateRepetitionHistory>
-        PreviousState DoMove(const Move move, const uint8_t ply, const bool quiet = false)
+        PreviousState DoMove(const InternalMove move, const uint8_t ply)
         {
             constexpr MoveType MT = NNUE | ZOBRIST;
 
-            if (!quiet || Board[move.From()].Piece() == Pawn) {
+            if (move.Captured() != NAP || move.Piece() == Pawn) {
                 Stack[ply + 1].HalfMoveCounter = 1;
             } else
                 Stack[ply + 1].HalfMoveCounter = Stack[ply].HalfMoveCounter + 1;
 
-            const PreviousState state = Board.Move<MT>(move.From(), move.To(), move.Promotion(), ThreadId);
-            Nodes++;
+            Stack[ply].MovedPiece = move.Piece();
+            Stack[ply].MovedTo    = move.To();
+
+            if (CopyMake) BoardStack[ply] = Board;
+
+            const PreviousState state = Board.Move<MT>(move, ThreadId);
+            CountNode();
 
             const ZobristHash hash = Board.Zobrist();
 
@@ -1158,41 +2066,144 @@ namespace StockDory
         }
 
         template<bool UpdateRepetitionHistory>
-        void UndoMove(const PreviousState state, const Move move)
+        void UndoMove(const PreviousState state, const Move move, const uint8_t ply)
         {
             constexpr MoveType MT = NNUE | ZOBRIST;
 
-            Board.UndoMove<MT>(state, move.From(), move.To(), ThreadId);
+            // The network's accumulators are kept on a stack of their own, which is still popped incrementally
+            if (CopyMake) {
+                Evaluation::PreUndoMove(ThreadId);
+                Board = BoardStack[ply];
+            } else Board.UndoMove<MT>(state, move.From(), move.To(), ThreadId);
 
             if (UpdateRepetitionHistory) Repetition.Pop();
         }
 
+        void CountNode()
+        {
+            State.Nodes.store(GetNodes() + 1, std::memory_order_relaxed);
+
+            if (++State.UnflushedNodes >= State.NodeBatch) [[unlikely]] FlushNodes();
+        }
+
+        void FlushNodes()
+        {
+            // Node Budget:
+            //
+            // The node limit applies to the search as a whole, not to each thread individually. Every thread flushes
+            // its locally counted nodes to the shared budget in batches, and all threads stop as soon as any of them
+            // finds the budget exhausted - so the total number of nodes searched stays (nearly) the same regardless of
+            // the number of threads searching
+            if (NodeBudget.Flush(State.UnflushedNodes, Limit.Nodes)) Stop();
+
+            State.UnflushedNodes = 0;
+        }
+
+        template<Color Color>
+        CHEntry* ContinuationEntry(CHTable& table, const uint8_t ply, const uint8_t plies)
+        {
+            // The entry for the move made the given number of plies ago, if there was one (and it wasn't a null move)
+            const SearchStack::Frame& frame = Stack[ply - plies];
+
+            if (frame.MovedPiece == NAP) return nullptr;
+
+            return &table[Color][frame.MovedPiece][frame.MovedTo];
+        }
+
+        template<Color Color>
+        int32_t QuietHistory(const Piece piece, const Square to,
+                             const CHEntry* counterMove, const CHEntry* followUp) const
+        {
+            // Averaged over the tables available for this position, keeping the result in the range of a single table
+            int32_t history = History[Color][piece][to];
+            int32_t tables  = 1;
+
+            if (counterMove) { history += (*counterMove)[piece][to]; tables++; }
+            if (   followUp) { history += (*   followUp)[piece][to]; tables++; }
+
+            return history / tables;
+        }
+
         template<Color Color, bool Increase>
-        void UpdateHistory(const Move move, const int16_t depth)
+        void UpdateHistory(const InternalMove move, const int16_t depth, const uint8_t ply)
         {
             const int16_t bonus = std::min<int16_t>(HistoryMultiplier * depth - HistoryShiftDown, HistoryLimit);
 
-            int16_t& history = History[Color][Board[move.From()].Piece()][move.To()];
+            const Piece piece = move.Piece();
 
-            history += bonus * (Increase ? 1 : -1) - history * bonus / HistoryLimit;
+            const auto update = [bonus](int16_t& history) -> void
+            {
+                history += bonus * (Increase ? 1 : -1) - history * bonus / HistoryLimit;
+            };
+
+            update(History[Color][piece][move.To()]);
+
+            if (!ContinuationHistory) return;
+
+            if (CHEntry* counterMove = ContinuationEntry<Color>(*CounterMoveHistory, ply, 1))
+                update((*counterMove)[piece][move.To()]);
+
+            if (CHEntry* followUp = ContinuationEntry<Color>(*FollowUpHistory, ply, 2))
+                update((*followUp)[piece][move.To()]);
         }
 
         template<Color Color>
-        Score EvaluateScaled() const
+        Score EvaluateCorrected() const
+        {
+            // Correction History:
+            //
+            // The static evaluation tends to be off in a consistent way for similar pawn structures (for example,
+            // underestimating passed pawns or overestimating weak pawn structures). The correction history learns how
+            // far off the static evaluation was from search results, per pawn structure, and corrects the static
+            // evaluation by that amount
+            const Score evaluation = EvaluateScaled<Color>();
+            const Score correction = PawnCorrection[Color][Board.PawnZobrist() % CorrectionHistorySize] /
+                                     CorrectionHistoryGrain;
+
+            return std::clamp<Score>(evaluation + correction, -MateInMaxDepth + 1, MateInMaxDepth - 1);
+        }
+
+        template<Color Color>
+        void UpdateCorrection(const Score difference, const int16_t depth)
+        {
+            int16_t& correction = PawnCorrection[Color][Board.PawnZobrist() % CorrectionHistorySize];
+
+            const int32_t weight = std::min<int32_t>(depth + 1, CorrectionHistoryMaximumWeight);
+            const int32_t target = difference * CorrectionHistoryGrain;
+
+            const int32_t value = (correction * (CorrectionHistoryWeightScale - weight) + target * weight) /
+                                  CorrectionHistoryWeightScale;
+
+            correction = static_cast<int16_t>(
+                std::clamp<int32_t>(value, -CorrectionHistoryLimit, CorrectionHistoryLimit)
+            );
+        }
+
+        template<Color Color>
+        int16_t CaptureHistoryOf(const InternalMove move) const
+        {
+            // En passant captures don't capture on their destination, and aren't kept track of
+            const Piece captured = move.Captured();
+
+            return captured == NAP ? 0 : CaptureHistory[Color][move.Piece()][move.To()][captured];
+        }
+
+        template<Color Color, bool Increase>
+        void UpdateCaptureHistory(const InternalMove move, const int16_t depth)
         {
-            const BitBoard pawn   = Board.PieceBoard(Pawn  , White) | Board.PieceBoard(Pawn  , Black);
-            const BitBoard knight = Board.PieceBoard(Knight, White) | Board.PieceBoard(Knight, Black);
-            const BitBoard bishop = Board.PieceBoard(Bishop, White) | Board.PieceBoard(Bishop, Black);
-            const BitBoard rook   = Board.PieceBoard(Rook  , White) | Board.PieceBoard(Rook  , Black);
-            const BitBoard queen  = Board.PieceBoard(Queen , White) | Board.PieceBoard(Queen , Black);
+            const int16_t bonus = std::min<int16_t>(HistoryMultiplier * depth - HistoryShiftDown, HistoryLimit);
 
-            uint16_t weightedMaterial = Count(pawn  ) * MaterialScalingWeightPawn   +
-                                        Count(knight) * MaterialScalingWeightKnight +
-                                        Count(bishop) * MaterialScalingWeightBishop +
-                                        Count(rook  ) * MaterialScalingWeightRook   +
-                                        Count(queen ) * MaterialScalingWeightQueen  ;
+            int16_t& history = CaptureHistory[Color][move.Piece()][move.To()][move.Captured()];
+
+            history += bonus * (Increase ? 1 : -1) - history * bonus / HistoryLimit;
+        }
 
-            weightedMaterial += MaterialScalingQuantization - MaterialScalingWeightedStartValue;
+        template<Color Color>
+        Score EvaluateScaled() const
+        {
+            // The board keeps the weighted material up to date as pieces come and go
+            const uint16_t weightedMaterial =
+                Board.WeightedMaterial() + MaterialScalingQuantization - MaterialScalingWeightedStartValue;
 
             return (Evaluation::Evaluate(Color, ThreadId) * weightedMaterial) / MaterialScalingQuantization;
         }
@@ -1220,23 +2231,24 @@ namespace StockDory
         public:
         ParallelTaskPool()
         {
-            Clear ();
             Resize();
         }
 
+        // The tasks are kept from one search to the next, so that they are only allocated when the number of threads
+        // changes and can reuse what they learned in their previous search
         void Resize()
         {
             TaskCount = ThreadPool.Size() - 1;
 
-            Internal.reserve(TaskCount);
+            Internal = std::vector<ParallelTask>(TaskCount);
         }
 
-        void Clear() { Internal.clear(); }
-
         size_t Size() const { return TaskCount; }
 
         void Fill(Limit& l, Board& b, RepetitionStack& r, const uint8_t hmc)
-        { for (size_t i = 0; i < TaskCount; i++) Internal.emplace_back(l, b, r, hmc, i + 1); }
+        { for (size_t i = 0; i < TaskCount; i++) Internal[i].Prepare(l, b, r, hmc, i + 1); }
+
+        void Forget() { for (auto& task : Internal) task.Forget(); }
 
         constexpr std::vector<ParallelTask>& operator &(){ return Internal; }
 
@@ -1255,13 +2267,46 @@ namespace StockDory
             {
                 IterativeDeepeningIterationCompletionEvent event = e;
 
-                for (const auto& task : &ParallelTaskPool) event.Nodes += task.GetNodes();
+                event.Nodes = Nodes();
 
                 return MainEventHandler::HandleIterativeDeepeningIterationCompletion(event);
             }
 
+            static void HandleSearchTimeStatistics(const SearchTimeStatisticsEvent& e)
+            { MainEventHandler::HandleSearchTimeStatistics(e); }
+
             static void HandleIterativeDeepeningCompletion(const IterativeDeepeningCompletionEvent& e)
-            { MainEventHandler::HandleIterativeDeepeningCompletion(e); }
+            {
+                if (!ParallelTaskPool.Size()) return MainEventHandler::HandleIterativeDeepeningCompletion(e);
+
+                // With multiple lines, the main task's lines are the ones reported, so its best move is played
+                const bool vote = MainTask.GetMultiPV() == 1;
+
+
+                // The main thread is responsible for ensuring that it stops all the parallel tasks when it has
+                // concluded searching. The results are only looked at once every one of them has actually finished
+                for (auto& task : &ParallelTaskPool) task.Stop();
+                for (auto& task : &ParallelTaskPool) while (!task.Finished()) Sleep(1);
+
+                const size_t best = vote ? Vote() : 0;
+
+                if (best == 0) return MainEventHandler::HandleIterativeDeepeningCompletion(e);
+
+                // The move being played comes from a parallel task, so its line is reported as well to keep the
+                // reported PV consistent with the move being played
+                const auto& task = (&ParallelTaskPool)[best - 1];
+
+                IterativeDeepeningIterationCompletionEvent event = task.IterationCompletionEvent();
+
+                event.Nodes = Nodes();
+                event.Time  = MainTask.ElapsedTime();
+
+                MainEventHandler::HandleIterativeDeepeningIterationCompletion(event);
+                MainEventHandler::HandleIterativeDeepeningCompletion({
+                    .Move       = task.GetResult().Move,
+                    .PonderMove = MainSearchTask::PonderMove(task.GetResult())
+                });
+            }
 
         };
 
@@ -1269,14 +2314,115 @@ namespace StockDory
 
         static inline MainSearchTask MainTask;
 
-        static inline bool Searching = false;
+        static inline std::atomic<bool> Searching = false;
+
+        static uint64_t Nodes()
+        {
+            // Every task's node counter lives on its own cache line and is read with relaxed ordering, so totalling
+            // them up does not slow down the threads that are searching
+            uint64_t nodes = MainTask.GetNodes();
+
+            for (const auto& task : &ParallelTaskPool) nodes += task.GetNodes();
 
-        static void Run(Limit& l, Board& b, RepetitionStack& r, const uint8_t hmc)
+            return nodes;
+        }
+
+        static const IterativeDeepeningResult& Result(const size_t index)
+        {
+            return index == 0 ? MainTask.GetResult() : (&ParallelTaskPool)[index - 1].GetResult();
+        }
+
+        static size_t Vote()
+        {
+            // Best Move Voting:
+            //
+            // Relevant links:
+            // - https://www.chessprogramming.org/Lazy_SMP
+            //
+            // Parallel tasks often complete deeper iterations than the main task, especially with their depths
+            // diversified, so discarding their results and playing the main task's move wastes their work. Instead,
+            // every task votes for the best move of its last completed iteration, with the vote weighted by how deep
+            // the iteration was and how good the evaluation was relative to the worst evaluation of all tasks:
+            //
+            // weight = (evaluation - minimum evaluation + offset) * depth
+            //
+            // The move with the most votes is played, reporting the line of the deepest task that found it. A proven
+            // win is always preferred though, taking the shortest one found by any task
+
+            const size_t count = ParallelTaskPool.Size() + 1;
+
+            Score minimum = Infinity;
+            for (size_t i = 0; i < count; i++)
+                if (Result(i).Depth) minimum = std::min(minimum, Result(i).Evaluation);
+
+            std::vector<std::pair<Move, int64_t>> votes;
+            votes.reserve(count);
+
+            const auto vote = [&votes](const Move move) -> int64_t&
+            {
+                for (auto& [m, v] : votes) if (m == move) return v;
+
+                return votes.emplace_back(move, 0).second;
+            };
+
+            for (size_t i = 0; i < count; i++) {
+                const IterativeDeepeningResult& result = Result(i);
+
+                if (!result.Depth) continue;
+
+                vote(result.Move) +=
+                    static_cast<int64_t>(result.Evaluation - minimum + HelperVoteEvaluationOffset) * result.Depth;
+            }
+
+            size_t best = 0;
+            for (size_t i = 1; i < count; i++) {
+                const IterativeDeepeningResult& result  = Result(i);
+                const IterativeDeepeningResult& current = Result(best);
+
+                if (!result.Depth) continue;
+
+                if (!current.Depth) {
+                    best = i;
+                    continue;
+                }
+
+                if (IsWin(current.Evaluation)) {
+                    if (result.Evaluation > current.Evaluation) best = i;
+                    continue;
+                }
+
+                const int64_t resultVotes  = vote(result .Move);
+                const int64_t currentVotes = vote(current.Move);
+
+                if (IsWin(result.Evaluation) || resultVotes > currentVotes ||
+                   (resultVotes == currentVotes && result.Depth > current.Depth))
+                    best = i;
+            }
+
+            return best;
+        }
+
+        static void PonderHit() { MainTask.PonderHit(); }
+
+        // Forgets the previous search, so that the next search doesn't reuse its state
+        static void Reset()
+        {
+            MainTask.Forget();
+
+            ParallelTaskPool.Forget();
+        }
+
+        static void Run(Limit& l, Board& b, RepetitionStack& r, const uint8_t hmc, const bool ponder = false)
         {
             if (Searching) return;
 
             Searching = true;
 
+            NodeBudget.Reset();
+
+            // Deferring moves only makes sense if there are other threads to defer them to
+            SearchingMoves.Enable(SMPMode == ABDADA && ParallelTaskPool.Size());
+
             // Symmetric MultiProcessing (SMP):
             //
             // Relevant links:
@@ -1309,6 +2455,11 @@ namespace StockDory
             // time remains relatively the same on average. This leads the engine to find better moves in the same
             // amount of time and avoid some pitfalls of the heuristical pruning, reduction, and search techniques used
 
+            // The main task is set up before any parallel task starts, as the parallel tasks report through it
+            MainTask.Prepare(l, b, r, hmc, 0);
+
+            if (ponder) MainTask.Ponder();
+
             if (ParallelTaskPool.Size()) {
                 ParallelTaskPool.Fill(l, b, r, hmc);
 
@@ -1320,22 +2471,13 @@ namespace StockDory
                 );
             }
 
-            MainTask = MainSearchTask(l, b, r, hmc, 0);
-
             ThreadPool.Execute(
                 [] -> void
                 {
+                    // The parallel tasks are stopped and waited for when the main task concludes searching (see
+                    // the completion handler), so the search is over once the main task returns
                     MainTask.IterativeDeepening();
 
-                    // The main thread is responsible for ensuring that it stops all the parallel tasks when it has
-                    // concluded searching
-                    if (ParallelTaskPool.Size()) {
-                        for (auto& task : &ParallelTaskPool) task.Stop();
-
-                        for (auto& task : &ParallelTaskPool) if (!task.Stopped()) Sleep(1);
-                    }
-
-                    ParallelTaskPool.Clear();
                     Searching = false;
                 }
             );
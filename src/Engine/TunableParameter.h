@@ -15,17 +15,50 @@ namespace StockDory
     constexpr uint8_t TimeBasePartitionDenominator      = 20;
     constexpr uint8_t TimeIncrementPartitionNumerator   = 3;
     constexpr uint8_t TimeIncrementPartitionDenominator = 4;
-    constexpr uint8_t TimeProcessingOverhead            = 10;
+    constexpr uint8_t TimeMaximumPartitionNumerator     = 3;
+    constexpr uint8_t TimeMaximumPartitionDenominator   = 4;
+
+    constexpr uint16_t EmergencyTimeThreshold        = 1000;
+    constexpr uint8_t  EmergencyTimeMaximumPartition =   10;
+    constexpr uint8_t  EmergencyTimeOptimalPartition =    2;
 
     constexpr Array<uint16_t, 5> SearchStabilityTimeOptimizationFactor {
         250, 180, 120, 99, 97
     };
 
+    constexpr uint8_t  SearchEffortMinimumDepth   =   5;
+    constexpr uint16_t NodeShareTimeBase          = 150;
+    constexpr uint16_t NodeShareTimeMultiplier    = 130;
+    constexpr uint16_t ScoreVolatilityTimeMinimum =  80;
+    constexpr uint16_t ScoreVolatilityTimeMaximum = 150;
+    constexpr uint16_t SearchEffortTimeMinimum    =  50;
+    constexpr uint16_t SearchEffortTimeMaximum    = 250;
+
+    constexpr uint8_t ContinuationMaximumPly = 4;
+
+    constexpr uint8_t  MateSearchDepthPerMove = 4;
+    constexpr uint32_t MateCheckBonus         = 1 << 30;
+
     constexpr uint16_t AspirationWindowFallbackBound = 3500;
     constexpr uint8_t  AspirationWindowMargin        = 16;
     constexpr uint8_t  AspirationWindowMarginDelta   = 23;
     constexpr uint8_t  AspirationWindowMinimumDepth  = 5;
 
+    constexpr uint8_t HelperStartDepthCycle          = 4;
+    constexpr uint8_t HelperWindowPerturbationCycle  = 4;
+    constexpr uint8_t HelperWindowPerturbationMargin = 6;
+
+    constexpr uint8_t HelperVoteEvaluationOffset     = 14;
+
+    constexpr Array<uint8_t, 20> HelperSkipSize  {
+        1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4
+    };
+    constexpr Array<uint8_t, 20> HelperSkipPhase {
+        0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7
+    };
+
+    constexpr uint8_t ABDADAMinimumDepth = 3;
+
     constexpr uint8_t CheckExtension = 1;
 
     constexpr uint8_t ReverseFutilityMaximumDepth    = 7;
@@ -40,6 +73,15 @@ namespace StockDory
     constexpr uint8_t NullMoveDepthFactor      = 3;
     constexpr uint8_t NullMoveEvaluationFactor = 180;
 
+    constexpr uint8_t  ProbCutMinimumDepth   =   5;
+    constexpr uint8_t  ProbCutDepthReduction =   4;
+    constexpr uint16_t ProbCutMargin         = 150;
+
+    constexpr uint8_t SingularMinimumDepth      = 10;
+    constexpr uint8_t SingularTTDepthMargin     =  3;
+    constexpr uint8_t SingularBetaDepthFactor   =  3;
+    constexpr uint8_t SingularNegativeExtension =  1;
+
     constexpr uint8_t IIRMinimumDepth   = 4;
     constexpr uint8_t IIRDepthReduction = 1;
 
@@ -61,13 +103,16 @@ namespace StockDory
     constexpr uint16_t HistoryMultiplier = 300;
     constexpr uint16_t HistoryShiftDown  = 250;
 
+    constexpr uint16_t CorrectionHistoryGrain         =  256;
+    constexpr uint16_t CorrectionHistoryWeightScale   =  256;
+    constexpr uint8_t  CorrectionHistoryMaximumWeight =   16;
+    constexpr uint16_t CorrectionHistoryLimit         = 8192;
+
+    constexpr uint8_t CaptureHistoryPolicyPartition     =   4;
+    constexpr uint8_t CaptureHistoryQuiescencePartition = 128;
+
     constexpr uint16_t MaterialScalingWeightedStartValue =  6688;
     constexpr uint16_t MaterialScalingQuantization       = 16384;
-    constexpr uint16_t MaterialScalingWeightPawn         =     0;
-    constexpr uint16_t MaterialScalingWeightKnight       =   308;
-    constexpr uint16_t MaterialScalingWeightBishop       =   346;
-    constexpr uint16_t MaterialScalingWeightRook         =   521;
-    constexpr uint16_t MaterialScalingWeightQueen        =   994;
 
     constexpr uint8_t TTReplacementDepthMargin = 3;
 
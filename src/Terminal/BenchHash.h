@@ -21,9 +21,8 @@ namespace StockDory
         constexpr static        uint8_t BenchLength =                  50  ;
                   static inline auto    BenchLimit  = Limit { .Depth = 13 };
 
-        static std::array<std::string, BenchLength> Positions;
-
         public:
+        static std::array<std::string, BenchLength> Positions;
 
         static void Run()
         {
@@ -42,6 +41,8 @@ namespace StockDory
 
                 repetition.Push(board.Zobrist());
 
+                NodeBudget.Reset();
+
                 SearchTask<> search (BenchLimit, board, repetition, hmc);
                 search.IterativeDeepening();
 
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_BENCHRESULT_H
+#define STOCKDORY_BENCHRESULT_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../Engine/Common.h"
+
+namespace StockDory
+{
+
+    struct BenchResult
+    {
+
+        uint64_t Nodes = 0;
+        MS       Time  {};
+
+        uint64_t NPS() const
+        {
+            return static_cast<uint64_t>(
+                static_cast<double>(Nodes) / (static_cast<double>(std::max<int64_t>(Time.count(), 1)) / 1000.0)
+            );
+        }
+
+    };
+
+} // StockDory
+
+#endif //STOCKDORY_BENCHRESULT_H
@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_MAKEBENCH_H
+#define STOCKDORY_MAKEBENCH_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "../Backend/Board.h"
+#include "../Backend/Move/MoveList.h"
+
+#include "../Engine/Common.h"
+#include "../Engine/Evaluation.h"
+#include "../Engine/OrderedMoveList.h"
+
+#include "BenchHash.h"
+#include "BenchResult.h"
+
+namespace StockDory
+{
+
+    class MakeBench
+    {
+
+        constexpr static uint8_t BenchLength = 8;
+        constexpr static uint8_t PerftDepth  = 4;
+        constexpr static uint8_t SearchDepth = 5;
+
+        constexpr static MoveType SearchMoveType = NNUE | ZOBRIST;
+
+        static inline KTable Killer  {};
+        static inline HTable History {};
+
+        // Both strategies are made to mirror the search: make/unmake keeps the previous state and unmakes the move,
+        // while copy-make saves the board before the move and restores it afterwards
+
+        template<Color Color, bool Copy>
+        static uint64_t PerftChild(Board& board, const uint8_t depth,
+                                   const Square from, const Square to, const Piece promotion = NAP)
+        {
+            uint64_t nodes;
+
+            if (Copy) {
+                const Board saved = board;
+
+                board.Move<STANDARD>(from, to, promotion);
+                nodes = Perft<Opposite(Color), Copy>(board, depth - 1);
+                board = saved;
+            } else {
+                const PreviousState state = board.Move<STANDARD>(from, to, promotion);
+                nodes = Perft<Opposite(Color), Copy>(board, depth - 1);
+                board.UndoMove<STANDARD>(state, from, to);
+            }
+
+            return nodes;
+        }
+
+        template<Piece Piece, Color Color, bool Copy>
+        static uint64_t PerftLoop(Board& board, const uint8_t depth, const PinBitBoard& pin, const CheckBitBoard& check)
+        {
+            uint64_t nodes = 0;
+
+            BitBoardIterator iterator (board.PieceBoard<Color>(Piece));
+
+            for (Square sq = iterator.Value(); sq != NASQ; sq = iterator.Value()) {
+                const MoveList<Piece, Color> moves (board, sq, pin, check);
+
+                if (depth == 1) {
+                    nodes += moves.Count() * (moves.Promotion(sq) ? 4 : 1);
+                    continue;
+                }
+
+                BitBoardIterator moveIterator = moves.Iterator();
+
+                for (Square m = moveIterator.Value(); m != NASQ; m = moveIterator.Value()) {
+                    if (moves.Promotion(sq)) {
+                        nodes += PerftChild<Color, Copy>(board, depth, sq, m, Queen );
+                        nodes += PerftChild<Color, Copy>(board, depth, sq, m, Rook  );
+                        nodes += PerftChild<Color, Copy>(board, depth, sq, m, Bishop);
+                        nodes += PerftChild<Color, Copy>(board, depth, sq, m, Knight);
+                    } else nodes += PerftChild<Color, Copy>(board, depth, sq, m);
+                }
+            }
+
+            return nodes;
+        }
+
+        template<Color Color, bool Copy>
+        static uint64_t Perft(Board& board, const uint8_t depth)
+        {
+            const PinBitBoard   pin   = board.Pin<Color, Opposite(Color)>();
+            const CheckBitBoard check = board.Check<Opposite(Color)>();
+
+            if (check.DoubleCheck) return PerftLoop<King, Color, Copy>(board, depth, pin, check);
+
+            return PerftLoop<Pawn  , Color, Copy>(board, depth, pin, check) +
+                   PerftLoop<Knight, Color, Copy>(board, depth, pin, check) +
+                   PerftLoop<Bishop, Color, Copy>(board, depth, pin, check) +
+                   PerftLoop<Rook  , Color, Copy>(board, depth, pin, check) +
+                   PerftLoop<Queen , Color, Copy>(board, depth, pin, check) +
+                   PerftLoop<King  , Color, Copy>(board, depth, pin, check);
+        }
+
+        // A plain fixed-depth alpha-beta search, ordering moves the way the search does and evaluating the leaves with
+        // the network, so that the accumulator updates are part of the measurement
+        template<Color Color, bool Copy>
+        static Score Search(Board& board, const uint8_t depth, Score alpha, const Score beta, uint64_t& nodes)
+        {
+            if (depth == 0) return Evaluation::Evaluate(Color);
+
+            OrderedMoveList<Color> moves (board, 0, Killer, History);
+
+            if (moves.Count() == 0) return board.Checked<Color>() ? -Mate : Draw;
+
+            Score bestEvaluation = -Infinity;
+            for (uint8_t i = 0; i < moves.Count(); i++) {
+                const InternalMove move = moves[i];
+
+                nodes++;
+
+                Score evaluation;
+
+                if (Copy) {
+                    const Board saved = board;
+
+                    board.Move<SearchMoveType>(move);
+                    evaluation = -Search<Opposite(Color), Copy>(board, depth - 1, -beta, -alpha, nodes);
+                    Evaluation::PreUndoMove();
+                    board = saved;
+                } else {
+                    const PreviousState state = board.Move<SearchMoveType>(move);
+                    evaluation = -Search<Opposite(Color), Copy>(board, depth - 1, -beta, -alpha, nodes);
+                    board.UndoMove<SearchMoveType>(state, move.From(), move.To());
+                }
+
+                if (evaluation <= bestEvaluation) continue;
+
+                bestEvaluation = evaluation;
+
+                if (evaluation <= alpha) continue;
+
+                alpha = evaluation;
+
+                if (evaluation >= beta) break;
+            }
+
+            return bestEvaluation;
+        }
+
+        template<bool Copy>
+        static BenchResult MeasurePerft()
+        {
+            BenchResult result;
+
+            for (size_t i = 0; i < BenchLength; i++) {
+                Board board (BenchHash::Positions[i]);
+
+                const auto start = std::chrono::steady_clock::now();
+
+                result.Nodes += board.ColorToMove() == White ? Perft<White, Copy>(board, PerftDepth)
+                                                             : Perft<Black, Copy>(board, PerftDepth);
+
+                result.Time += std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - start);
+            }
+
+            return result;
+        }
+
+        template<bool Copy>
+        static BenchResult MeasureSearch()
+        {
+            BenchResult result;
+
+            for (size_t i = 0; i < BenchLength; i++) {
+                Board board (BenchHash::Positions[i]);
+
+                board.LoadForEvaluation();
+
+                const auto start = std::chrono::steady_clock::now();
+
+                if (board.ColorToMove() == White)
+                    Search<White, Copy>(board, SearchDepth, -Infinity, Infinity, result.Nodes);
+                else
+                    Search<Black, Copy>(board, SearchDepth, -Infinity, Infinity, result.Nodes);
+
+                result.Time += std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - start);
+            }
+
+            return result;
+        }
+
+        static void Report(const std::string& name, const BenchResult perft, const BenchResult search)
+        {
+            std::cout << std::setfill(' ') << std::left  << std::setw(11) << name          << " | "
+                                           << std::right << std::setw(12) << perft .NPS()  << " | "
+                                                         << std::setw(12) << search.NPS()  << std::endl;
+        }
+
+        public:
+        static void Run()
+        {
+            // Make/Unmake vs. Copy-Make:
+            //
+            // Measures how fast each way of taking a move back is, in perft (move generation and making moves only)
+            // and in a search-like workload (move ordering and network updates on top). Copy-make trades unmaking a
+            // move for copying the board, which is worth it when copying is cheaper than unmaking on the target - the
+            // search is built with copy-make if BUILD_COPY_MAKE is enabled
+
+            std::cout << "Mode        | Perft NPS    | Search NPS" << std::endl;
+
+            Report("Make/Unmake", MeasurePerft<false>(), MeasureSearch<false>());
+            Report("Copy-Make"  , MeasurePerft<true >(), MeasureSearch<true >());
+
+            std::cout << std::endl << "Search built with: " << (CopyMake ? "Copy-Make" : "Make/Unmake") << std::endl;
+        }
+
+    };
+
+} // StockDory
+
+#endif //STOCKDORY_MAKEBENCH_H
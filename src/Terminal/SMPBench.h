@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2025 StockDory authors. See the list of authors for more details.
+// Licensed under LGPL-3.0.
+//
+
+#ifndef STOCKDORY_SMPBENCH_H
+#define STOCKDORY_SMPBENCH_H
+
+#include <iomanip>
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../Backend/ThreadPool.h"
+
+#include "../Engine/Search.h"
+
+#include "BenchHash.h"
+#include "BenchResult.h"
+
+namespace StockDory
+{
+
+    class SMPBench
+    {
+
+        using Search = ThreadedSearch<>;
+
+        constexpr static uint8_t  BenchLength = 8;
+        constexpr static uint64_t BenchTime   = 2000;
+        constexpr static uint8_t  BenchDepth  = 13;
+
+        // The thread counts are doubled up to this many threads, after which only all the hardware threads are measured
+        constexpr static size_t BenchMaximumThreads = 32;
+
+        static std::vector<size_t> ThreadCounts()
+        {
+            std::vector<size_t> counts;
+
+            const size_t limit = ThreadPool::HardwareLimit();
+
+            for (size_t threads = 1; threads < limit && threads <= BenchMaximumThreads; threads *= 2)
+                counts.push_back(threads);
+
+            counts.push_back(limit);
+
+            return counts;
+        }
+
+        static void SetThreads(const size_t threads)
+        {
+            ThreadPool.Resize(threads);
+
+            Evaluation::Initialize();
+            Search::ParallelTaskPool.Resize();
+        }
+
+        static BenchResult Measure(const Limit& limit)
+        {
+            BenchResult result;
+
+            for (size_t i = 0; i < BenchLength; i++) {
+                const std::string& fen = BenchHash::Positions[i];
+
+                Board           board (fen);
+                RepetitionStack repetition;
+
+                repetition.Push(board.Zobrist());
+
+                const auto hmc = static_cast<uint8_t>(std::stoi(strutil::split(fen, ' ')[4]));
+
+                Limit l = limit;
+
+                TT.Clear();
+
+                const auto start = std::chrono::steady_clock::now();
+
+                Search::Run(l, board, repetition, hmc);
+                while (Search::Searching) Sleep(1);
+
+                result.Time  += std::chrono::duration_cast<MS>(std::chrono::steady_clock::now() - start);
+                result.Nodes += NodeBudget.Nodes();
+            }
+
+            return result;
+        }
+
+        static void ReportSpeed(const MS time)
+        {
+            // Thread Scaling:
+            //
+            // Searches the same positions for the same amount of time at every thread count from a single thread up to
+            // every logical processor available, reporting the total speed (nps) and how well it scales with the number
+            // of threads. Ideally, the speed scales linearly - anything less is overhead from threads contending for
+            // shared resources (memory bandwidth, the transposition table, or cache lines shared between threads)
+
+            const Limit limit {
+                .Timed       = true,
+                .Fixed       = true,
+                .ActualTime  = time,
+                .OptimalTime = time
+            };
+
+            std::cout << "Threads | Nodes          | NPS          | Scaling | Efficiency" << std::endl;
+
+            uint64_t baseline = 0;
+            for (const size_t threads : ThreadCounts()) {
+                SetThreads(threads);
+
+                const BenchResult result = Measure(limit);
+
+                if (threads == 1) baseline = std::max<uint64_t>(result.NPS(), 1);
+
+                const double scaling = static_cast<double>(result.NPS()) / static_cast<double>(baseline);
+
+                std::cout << std::setfill(' ') << std::fixed << std::setprecision(2)
+                          << std::setw( 7) << threads       << " | "
+                          << std::setw(14) << result.Nodes  << " | "
+                          << std::setw(12) << result.NPS()  << " | "
+                          << std::setw( 6) << scaling       << "x | "
+                          << std::setw( 9) << scaling / static_cast<double>(threads) * 100 << "%"
+                          << std::endl;
+            }
+        }
+
+        struct Configuration
+        {
+
+            std::string                        Name            ;
+            ParallelSearchMode                 Mode            ;
+            HelperDiversificationConfiguration Diversification ;
+
+        };
+
+        static void ReportTimeToDepth(const uint8_t depth)
+        {
+            // Time To Depth (TTD):
+            //
+            // Searches the same positions to the same depth at every thread count, with the helper threads searching:
+            // - Uniform    : the same depths with the same windows as the main thread (Lazy SMP)
+            // - Diversified: the configured depths and windows (Lazy SMP)
+            // - ABDADA     : the configured depths and windows, deferring moves other threads are searching
+            //
+            // The effective speedup is how much faster the depth is reached compared to a single thread, which (unlike
+            // the speed) accounts for helper threads duplicating work instead of sharing it
+
+            const Limit limit { .Depth = depth };
+
+            const ParallelSearchMode                 mode            = SMPMode;
+            const HelperDiversificationConfiguration diversification = HelperDiversification;
+
+            const std::array<Configuration, 3> configurations = {{
+                { "Uniform"    , LazySMP, { .StartDepth = false, .SkipDepth = false, .WindowPerturbation = 0 } },
+                { "Diversified", LazySMP, diversification },
+                { "ABDADA"     , ABDADA , diversification }
+            }};
+
+            std::cout << "Threads";
+            for (const auto& configuration : configurations)
+                std::cout << " | " << std::setw(11) << configuration.Name << " TTD | Speedup";
+            std::cout << std::endl;
+
+            double baseline = 0;
+            for (const size_t threads : ThreadCounts()) {
+                SetThreads(threads);
+
+                std::cout << std::setfill(' ') << std::fixed << std::setprecision(2) << std::setw(7) << threads;
+
+                BenchResult single;
+                for (const auto& configuration : configurations) {
+                    SMPMode               = configuration.Mode;
+                    HelperDiversification = configuration.Diversification;
+
+                    // A single thread searches the same way regardless of the configuration
+                    const BenchResult result = threads == 1 && single.Time.count() ? single : Measure(limit);
+
+                    if (threads == 1) single = result;
+
+                    const auto time = static_cast<double>(std::max<int64_t>(result.Time.count(), 1));
+
+                    if (threads == 1) baseline = time;
+
+                    std::cout << " | " << std::setw(13) << result.Time.count() << "ms"
+                              << " | " << std::setw( 6) << baseline / time     << "x";
+                }
+
+                std::cout << std::endl;
+            }
+
+            SMPMode               = mode;
+            HelperDiversification = diversification;
+        }
+
+        public:
+        static void Run(const MS time = MS(BenchTime), const uint8_t depth = BenchDepth)
+        {
+            const size_t previous = ThreadPool.Size();
+
+            ReportSpeed(time);
+
+            std::cout << std::endl;
+
+            ReportTimeToDepth(depth);
+
+            SetThreads(previous);
+        }
+
+    };
+
+} // StockDory
+
+#endif //STOCKDORY_SMPBENCH_H
@@ -6,10 +6,13 @@
 #ifndef STOCKDORY_UCIINTERFACE_H
 #define STOCKDORY_UCIINTERFACE_H
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <ranges>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "Information.h"
@@ -50,6 +53,12 @@ namespace StockDory
         static inline RepetitionStack      Repetition {};
         static inline uint8_t         HalfMoveCounter {};
 
+        // The arguments of the position command the board was last set up from
+        static inline Arguments PositionArguments {};
+
+        static inline uint8_t  MultiPV      =  1;
+        static inline uint16_t MoveOverhead = 10;
+
         static inline UCISearchEventHandler SearchEventHandler;
 
         public:
@@ -77,6 +86,7 @@ namespace StockDory
             UCICommandSwitch.emplace("position",   [](const Arguments& args) { HandlePosition(args); });
             UCICommandSwitch.emplace("go",         [](const Arguments& args) { HandleGo(args);       });
             UCICommandSwitch.emplace("stop",       [](const Arguments&     ) { HandleStop();         });
+            UCICommandSwitch.emplace("ponderhit",  [](const Arguments&     ) { HandlePonderHit();    });
         }
 
         static void RegisterOptions()
@@ -127,9 +137,111 @@ namespace StockDory
                     }
                 );
 
-            UCIOptionSwitch.emplace(   hash->GetName(), hash   );
-            UCIOptionSwitch.emplace(threads->GetName(), threads);
-            UCIOptionSwitch.emplace(    wdl->GetName(), wdl    );
+            auto timeStatistics =
+                std::make_shared<UCIOption<bool>>
+                ("TimeStatistics", false, [](const bool& value) -> void
+                    {
+                        UCISearchEventHandler::SetOutputTimeStatistics(value);
+                    }
+                );
+
+            auto helperStartDepth =
+                std::make_shared<UCIOption<bool>>
+                ("HelperStartDepth", HelperDiversification.StartDepth, [](const bool& value) -> void
+                    {
+                        HelperDiversification.StartDepth = value;
+                    }
+                );
+
+            auto helperSkipDepth =
+                std::make_shared<UCIOption<bool>>
+                ("HelperSkipDepth", HelperDiversification.SkipDepth, [](const bool& value) -> void
+                    {
+                        HelperDiversification.SkipDepth = value;
+                    }
+                );
+
+            auto helperWindowPerturbation =
+                std::make_shared<UCIOption<size_t>>
+                ("HelperWindowPerturbation", HelperDiversification.WindowPerturbation, 0, 64,
+                    [](const size_t& value) -> void
+                    {
+                        if (value > 64) {
+                            std::cerr << "ERROR: Helper window perturbation must be at most 64" << std::endl;
+                            return;
+                        }
+
+                        HelperDiversification.WindowPerturbation = value;
+                    }
+                );
+
+            auto moveOverhead =
+                std::make_shared<UCIOption<size_t>>
+                ("Move Overhead", MoveOverhead, 0, 5000, [](const size_t& value) -> void
+                    {
+                        if (value > 5000) {
+                            std::cerr << "ERROR: Move overhead must be at most 5000 ms" << std::endl;
+                            return;
+                        }
+
+                        MoveOverhead = value;
+                    }
+                );
+
+            auto ponder =
+                std::make_shared<UCIOption<bool>>
+                ("Ponder", false, [](const bool&) -> void
+                    {
+                        // The GUI decides when to ponder (go ponder), this option only tells it that we can
+                    }
+                );
+
+            auto multiPV =
+                std::make_shared<UCIOption<size_t>>
+                ("MultiPV", 1, 1, MaxMove, [](const size_t& value) -> void
+                    {
+                        if (value < 1) {
+                            std::cerr << "ERROR: MultiPV must be at least 1" << std::endl;
+                            return;
+                        }
+
+                        if (value > MaxMove) {
+                            std::cerr << "ERROR: MultiPV exceeds the maximum number of moves in a position" << std::endl;
+                            return;
+                        }
+
+                        MultiPV = value;
+                    }
+                );
+
+            auto abdada =
+                std::make_shared<UCIOption<bool>>
+                ("ABDADA", SMPMode == ABDADA, [](const bool& value) -> void
+                    {
+                        SMPMode = value ? ABDADA : LazySMP;
+                    }
+                );
+
+            auto continuationHistory =
+                std::make_shared<UCIOption<bool>>
+                ("ContinuationHistory", ContinuationHistory, [](const bool& value) -> void
+                    {
+                        ContinuationHistory = value;
+                    }
+                );
+
+            UCIOptionSwitch.emplace(                   hash->GetName(), hash                    );
+            UCIOptionSwitch.emplace(                threads->GetName(), threads                 );
+            UCIOptionSwitch.emplace(                    wdl->GetName(), wdl                     );
+            UCIOptionSwitch.emplace(         timeStatistics->GetName(), timeStatistics          );
+            UCIOptionSwitch.emplace(       helperStartDepth->GetName(), helperStartDepth        );
+            UCIOptionSwitch.emplace(        helperSkipDepth->GetName(), helperSkipDepth         );
+            UCIOptionSwitch.emplace(helperWindowPerturbation->GetName(), helperWindowPerturbation);
+            UCIOptionSwitch.emplace(           moveOverhead->GetName(), moveOverhead            );
+            UCIOptionSwitch.emplace(                 ponder->GetName(), ponder                  );
+            UCIOptionSwitch.emplace(                multiPV->GetName(), multiPV                 );
+            UCIOptionSwitch.emplace(                 abdada->GetName(), abdada                  );
+            UCIOptionSwitch.emplace(    continuationHistory->GetName(), continuationHistory     );
         }
 
         static void HandleInput(const std::string& input)
@@ -165,12 +277,20 @@ namespace StockDory
         {
             if (!UCIPrompted || args.size() < 4) return;
 
-            if (!UCIOptionSwitch.contains(args[1])) return;
+            // Option names may contain spaces, so the name is every argument between "name" and "value"
+            const auto value = std::find(args.begin() + 2, args.end(), "value");
+
+            if (value == args.end()) return;
+
+            const std::vector<std::string> nameLeading = {args.begin() + 1, value};
+            const std::string              name        = strutil::join(nameLeading, " ");
 
-            const std::vector<std::string> parameterLeading = {args.begin() + 3, args.end()};
+            if (!UCIOptionSwitch.contains(name)) return;
+
+            const std::vector<std::string> parameterLeading = {value + 1, args.end()};
             const std::string              parameter        = strutil::join(parameterLeading, "");
 
-            UCIOptionSwitch[args[1]]->Set(parameter);
+            UCIOptionSwitch[name]->Set(parameter);
         }
 
         static void UciNewGame()
@@ -180,13 +300,16 @@ namespace StockDory
             if (UCISearch::Searching) UCISearch::MainTask.Stop();
             while (UCISearch::Searching) Sleep(1);
 
-            Board           = {};
-            Repetition      = {};
-            HalfMoveCounter =  1;
+            Board             = {};
+            Repetition        = {};
+            HalfMoveCounter   =  1;
+            PositionArguments = {};
 
             Repetition.Push(Board.Zobrist());
 
             TT.Clear();
+
+            UCISearch::Reset();
         }
 
         static void IsReady()
@@ -237,8 +360,22 @@ namespace StockDory
         {
             if (!UCIPrompted) return;
 
-            uint8_t moveStrIndex = 2;
-            if (strutil::compare_ignore_case(args[0], "fen")) {
+            const bool fromFen = strutil::compare_ignore_case(args[0], "fen");
+            if (!fromFen && !strutil::compare_ignore_case(args[0], "startpos")) return;
+
+            const size_t moveStrIndex = fromFen ? 8 : 2;
+
+            // Incremental Position:
+            //
+            // GUIs send the whole game again with every move, so most position commands are the previous command with
+            // a move or two appended. In that case, the board, the repetition history, and the half-move counter are
+            // still where the previous command left them, and only the appended moves have to be made, instead of
+            // setting up the position again and replaying the entire game
+            size_t firstMoveStrIndex = moveStrIndex;
+            if (!PositionArguments.empty() && args.size() >= PositionArguments.size() &&
+                std::equal(PositionArguments.begin(), PositionArguments.end(), args.begin())) {
+                firstMoveStrIndex = std::max(moveStrIndex, PositionArguments.size());
+            } else if (fromFen) {
                 const Arguments   fenToken = {args.begin() + 1, args.begin() + 7};
                 const std::string fen      = strutil::join(fenToken, " ");
 
@@ -247,21 +384,20 @@ namespace StockDory
                 HalfMoveCounter = std::stoi(fenToken[4]);
 
                 Repetition.Push(Board.Zobrist());
-
-                moveStrIndex = 8;
-            } else if (strutil::compare_ignore_case(args[0], "startpos")) {
+            } else {
                 Board      = {};
                 Repetition = {};
 
                 Repetition.Push(Board.Zobrist());
                 HalfMoveCounter = 1;
-            } else return;
+            }
+
+            PositionArguments = args;
 
             if (args.size() >= moveStrIndex &&
                 strutil::compare_ignore_case(args[moveStrIndex - 1], "moves"))
-                for (const Arguments movesToken = {args.begin() + moveStrIndex, args.end()};
-                     const std::string& moveStr: movesToken) {
-                    const Move move = Move::FromString(moveStr);
+                for (size_t i = firstMoveStrIndex; i < args.size(); i++) {
+                    const Move move = Move::FromString(args[i]);
 
                     if (Board[move.To()].Piece() != NAP || Board[move.From()].Piece() == Pawn) HalfMoveCounter = 1;
                     else                                                                       HalfMoveCounter++;
@@ -272,15 +408,18 @@ namespace StockDory
                 }
         }
 
-        template<typename T>
-        // ReSharper disable once CppDFAConstantParameter
-        static T TokenToValue(const Arguments& args, const std::string& token, const T defaultValue)
+        static bool Legal(const Move move)
         {
-            for (size_t i = 0; i < args.size(); i++)
-                if (strutil::compare_ignore_case(args[i], token) && i + 1 < args.size())
-                    return static_cast<T>(std::stoull(args[i + 1]));
+            const auto contains = [move]<Color Color>(const OrderedMoveList<Color>& moves) -> bool
+            {
+                for (uint8_t i = 0; i < moves.Count(); i++) if (moves.UnsortedAccess(i) == move) return true;
 
-            return defaultValue;
+                return false;
+            };
+
+            if (Board.ColorToMove() == White)
+                 return contains(OrderedMoveList<White>(Board, 0, {}, {}, {}));
+            else return contains(OrderedMoveList<Black>(Board, 0, {}, {}, {}));
         }
 
         static void HandleGo(const Arguments& args)
@@ -299,32 +438,72 @@ namespace StockDory
                 return;
             }
 
-            Limit limit;
+            static const std::unordered_set<std::string> Tokens = {
+                "searchmoves", "ponder", "wtime", "btime", "winc", "binc", "movestogo",
+                "depth", "nodes", "mate", "movetime", "infinite"
+            };
+
+            Limit limit { .MultiPV = MultiPV };
+
+            UCITime<false> time { .Overhead = MoveOverhead, .ColorToMove = Board.ColorToMove() };
+
+            std::optional<uint64_t> moveTime;
+
+            bool clock  = false;
+            bool depth  = false;
+            bool ponder = false;
 
-            if (args.size() == 2) {
-                if (strutil::compare_ignore_case(args[0], "depth"))
-                    limit.Depth = static_cast<uint8_t>(std::stoull(args[1]));
-                if (strutil::compare_ignore_case(args[0], "nodes"))
-                    limit.Nodes =                      std::stoull(args[1]) ;
-                if (strutil::compare_ignore_case(args[0], "movetime")) {
-                    const UCITime<true> time { .Time = std::stoull(args[1]) };
-                    time.AsLimit(limit);
+            for (size_t i = 0; i < args.size(); i++) {
+                const std::string token = strutil::to_lower(args[i]);
+
+                if        (token == "ponder"     ) {
+                    ponder = true;
+                } else if (token == "infinite"   ) {
+                    limit.Infinite = true;
+                } else if (token == "searchmoves") {
+                    // Every argument up to the next token is a move to restrict the search to. Illegal moves are
+                    // ignored, leaving the search unrestricted if none of the moves are legal
+                    while (i + 1 < args.size() && !Tokens.contains(strutil::to_lower(args[i + 1]))) {
+                        const Move move = Move::FromString(args[++i]);
+
+                        if (Legal(move)) limit.SearchMoves.push_back(move);
+                    }
+                } else if (Tokens.contains(token) && i + 1 < args.size()) {
+                    // GUIs can send a negative remaining time once the clock has run out, which is treated as no time
+                    // left rather than being wrapped around to an enormous amount of time. Unknown tokens are skipped
+                    // on their own, leaving whatever follows them to be read as a token again
+                    const auto value = static_cast<uint64_t>(std::max<int64_t>(std::stoll(args[++i]), 0));
+
+                    if      (token == "wtime"    ) { time.WhiteTime = value; clock = true; }
+                    else if (token == "btime"    ) { time.BlackTime = value; clock = true; }
+                    else if (token == "winc"     )   time.WhiteInc  = value;
+                    else if (token == "binc"     )   time.BlackInc  = value;
+                    else if (token == "movestogo")   time.MovesToGo = static_cast<uint16_t>(value);
+                    else if (token == "movetime" )   moveTime       = value;
+                    else if (token == "nodes"    )   limit.Nodes    = value;
+                    else if (token == "mate"     )
+                        limit.Mate  = static_cast<uint8_t>(std::clamp<uint64_t>(value, 1, MaxDepth / 2));
+                    else if (token == "depth"    ) {
+                        limit.Depth = static_cast<uint8_t>(std::clamp<uint64_t>(value, 1, MaxDepth - 1));
+                        depth       = true;
+                    }
                 }
-            } else if (args.size() > 2) {
-                const UCITime<false> time {
-                    .WhiteTime = TokenToValue<uint64_t>(args, "wtime"    , 0),
-                    .BlackTime = TokenToValue<uint64_t>(args, "btime"    , 0),
-                    .WhiteInc  = TokenToValue<uint64_t>(args, "winc"     , 0),
-                    .BlackInc  = TokenToValue<uint64_t>(args, "binc"     , 0),
-                    .MovesToGo = TokenToValue<uint16_t>(args, "movestogo", 0),
-
-                    .ColorToMove = Board.ColorToMove()
-                };
-
-                time.AsLimit(limit);
             }
 
-            UCISearch::Run(limit, Board, Repetition, HalfMoveCounter);
+            // A mate search is limited to a depth a mate within the requested number of moves is very likely to be
+            // found by, unless another depth is given
+            if (limit.Mate && !depth)
+                limit.Depth = static_cast<uint8_t>(std::min(limit.Mate * MateSearchDepthPerMove, MaxDepth - 1));
+
+            if (limit.Infinite) {
+                // An infinite search runs until it is stopped, ignoring the clock
+                if (!depth) limit.Depth = MaxDepth - 1;
+            } else if (moveTime) {
+                const UCITime<true> fixed { .Time = *moveTime, .Overhead = MoveOverhead };
+                fixed.AsLimit(limit);
+            } else if (clock) time.AsLimit(limit);
+
+            UCISearch::Run(limit, Board, Repetition, HalfMoveCounter, ponder);
         }
 
         static void HandleStop()
@@ -334,6 +513,13 @@ namespace StockDory
             UCISearch::MainTask.Stop();
         }
 
+        static void HandlePonderHit()
+        {
+            if (!UCIPrompted || !UCISearch::Searching) return;
+
+            UCISearch::PonderHit();
+        }
+
     };
 
 } // StockDory
@@ -6,6 +6,9 @@
 #ifndef STOCKDORY_UCISEARCHEVENTHANDLER_H
 #define STOCKDORY_UCISEARCHEVENTHANDLER_H
 
+#include <iomanip>
+#include <sstream>
+
 #include "../../Engine/Search.h"
 
 namespace StockDory
@@ -14,7 +17,8 @@ namespace StockDory
     class UCISearchEventHandler : DefaultSearchEventHandler
     {
 
-        static inline bool OutputWDL = false;
+        static inline bool OutputWDL            = false;
+        static inline bool OutputTimeStatistics = false;
 
         static std::string PVLine(const PVEntry& pv)
         {
@@ -43,6 +47,8 @@ namespace StockDory
             output << "info depth " << static_cast<uint16_t>(event.         Depth) << " ";
             output <<   "seldepth " << static_cast<uint16_t>(event.SelectiveDepth) << " ";
 
+            if (event.Lines > 1) output << "multipv " << static_cast<uint16_t>(event.Line) << " ";
+
             output << "score ";
 
             if (IsMate(event.Evaluation)) {
@@ -63,11 +69,39 @@ namespace StockDory
 
         static void HandleIterativeDeepeningCompletion(const IterativeDeepeningCompletionEvent& event)
         {
-            std::cout << "bestmove " << event.Move.ToString() << std::endl;
+            std::stringstream output;
+
+            output << "bestmove " << event.Move.ToString();
+
+            if (event.PonderMove) output << " ponder " << event.PonderMove.ToString();
+
+            std::cout << output.str() << std::endl;
+        }
+
+        static void HandleSearchTimeStatistics(const SearchTimeStatisticsEvent& event)
+        {
+            if (!OutputTimeStatistics) return;
+
+            std::stringstream output;
+
+            output << "info string time";
+            output << " depth "     << event.Depth;
+            output << " elapsed "   << event.Time       .count();
+            output << " optimal "   << event.OptimalTime.count();
+            output << " soft "      << event.SoftTime   .count();
+            output << " hard "      << event.ActualTime .count();
+            output << " stability " << static_cast<uint16_t>(event.Stability);
+            output << " nodeshare " << std::fixed << std::setprecision(2) << event.NodeShare;
+            output << " scoredelta " << event.EvaluationDelta;
+            output << " effort "    << event.Effort << "%";
+
+            std::cout << output.str() << std::endl;
         }
 
         static void SetOutputWDL(const bool value) { OutputWDL = value; }
 
+        static void SetOutputTimeStatistics(const bool value) { OutputTimeStatistics = value; }
+
     };
 
 } // StockDory
@@ -6,6 +6,8 @@
 #ifndef STOCKDORY_UCITIME_H
 #define STOCKDORY_UCITIME_H
 
+#include <algorithm>
+
 #include "../../Engine/Search.h"
 
 namespace StockDory
@@ -18,15 +20,18 @@ namespace StockDory
     struct UCITime<true>
     {
 
-        uint64_t Time = 0;
+        uint64_t Time     = 0;
+        uint64_t Overhead = 0;
 
         void AsLimit(Limit& limit) const
         {
             limit.Timed = true;
             limit.Fixed = true;
 
-            limit.ActualTime  = MS(Time);
-            limit.OptimalTime = MS(Time);
+            const uint64_t time = Time > Overhead ? Time - Overhead : 0;
+
+            limit.ActualTime  = MS(time);
+            limit.OptimalTime = MS(time);
         }
 
     };
@@ -42,6 +47,8 @@ namespace StockDory
 
         uint16_t MovesToGo  = 0;
 
+        uint64_t Overhead   = 0;
+
         Color ColorToMove = NAC;
 
         void AsLimit(Limit& limit) const
@@ -52,16 +59,31 @@ namespace StockDory
             const uint64_t time = ColorToMove == White ? WhiteTime : BlackTime;
             const uint64_t inc  = ColorToMove == White ? WhiteInc  : BlackInc ;
 
-            uint64_t actualTime = time * TimeBasePartitionNumerator / TimeBasePartitionDenominator;
+            // The time lost to communication with the GUI (and the network between us) is never available to us, so
+            // it is taken off the clock before anything else, without wrapping around when it exceeds the clock
+            const uint64_t available = time > Overhead ? time - Overhead : 0;
 
-            actualTime = MovesToGo > 0 ? std::max(actualTime, time / MovesToGo) : actualTime;
+            uint64_t actualTime = available * TimeBasePartitionNumerator / TimeBasePartitionDenominator;
+
+            actualTime = MovesToGo > 0 ? std::max(actualTime, available / MovesToGo) : actualTime;
 
             actualTime += inc * TimeIncrementPartitionNumerator / TimeIncrementPartitionDenominator;
 
-            actualTime -= TimeProcessingOverhead;
+            // Emergency Mode:
+            //
+            // With less than a second on the clock, every millisecond is precious and an unlucky search could flag.
+            // Instead of relying on the increment to refill the clock, only a small fraction of the remaining time is
+            // used, and the search is expected to stop well before the hard limit
+            const bool emergency = time < EmergencyTimeThreshold;
+
+            const uint64_t maximumTime = emergency ? available / EmergencyTimeMaximumPartition
+                                                   : available * TimeMaximumPartitionNumerator
+                                                               / TimeMaximumPartitionDenominator;
+
+            actualTime = std::min(actualTime, maximumTime);
 
             limit.ActualTime  = MS(actualTime);
-            limit.OptimalTime = MS(actualTime);
+            limit.OptimalTime = MS(emergency ? actualTime / EmergencyTimeOptimalPartition : actualTime);
         }
 
     };
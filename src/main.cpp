@@ -8,6 +8,8 @@
 #include "Information.h"
 
 #include "Terminal/BenchHash.h"
+#include "Terminal/MakeBench.h"
+#include "Terminal/SMPBench.h"
 #include "Terminal/UCI/UCIInterface.h"
 
 void DisplayTitle()
@@ -31,6 +33,16 @@ int main(const int argc, const char* argv[])
             StockDory::BenchHash::Run();
             return EXIT_SUCCESS;
         }
+
+        if (strutil::compare_ignore_case(argv[1], "smpbench")) {
+            StockDory::SMPBench::Run();
+            return EXIT_SUCCESS;
+        }
+
+        if (strutil::compare_ignore_case(argv[1], "makebench")) {
+            StockDory::MakeBench::Run();
+            return EXIT_SUCCESS;
+        }
     }
 
     StockDory::UCIInterface::Launch();